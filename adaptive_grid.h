@@ -0,0 +1,152 @@
+#ifndef ADAPTIVE_GRID_H
+#define ADAPTIVE_GRID_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "solver_stats.h"
+
+using namespace std;
+
+// Resolution of the adaptive grid search over a probability in [0, 1]
+struct GridSearchOptions {
+    int coarse_intervals; // Intervals of the first, uniform pass
+    double precision;     // Width of the finest grid cells; sign changes are located this closely
+    double tolerance;     // Values within tolerance of zero count as zero
+    
+    GridSearchOptions(int coarse = 16, double prec = 1e-9, double tol = 0.0)
+        : coarse_intervals(coarse), precision(prec), tolerance(tol) {}
+};
+
+// Closed range [lo, hi] of probabilities on which a function keeps one sign:
+// 1 positive, -1 negative, 0 zero. A sign change inside a finest grid cell is
+// reported as a zero run with lo == hi at the interpolated root.
+struct SignRun {
+    double lo;
+    double hi;
+    int sign;
+};
+
+// Points of the grid are integer indices k over a fixed finest resolution,
+// x = k / points, so no probability is ever accumulated and both ends are exact
+class AdaptiveGrid {
+private:
+    uint64_t points;
+    uint64_t coarse_step;
+
+public:
+    explicit AdaptiveGrid(const GridSearchOptions& options) {
+        uint64_t coarse = options.coarse_intervals > 0 ? (uint64_t)options.coarse_intervals : 1;
+        int depth = 0;
+        // Stop well before the indices stop being exact doubles
+        while ((double)(coarse << depth) * options.precision < 1.0 && depth < 40) {
+            depth++;
+        }
+        coarse_step = 1ULL << depth;
+        points = coarse << depth;
+    }
+    
+    uint64_t numPoints() const { return points; }
+    uint64_t coarseStep() const { return coarse_step; }
+    double at(uint64_t k) const { return (double)k / (double)points; }
+};
+
+namespace adaptive_grid_detail {
+
+struct Sample {
+    uint64_t k;
+    double x;
+    double value;
+    int sign;
+};
+
+template<class Fn>
+Sample sample(Fn& f, const AdaptiveGrid& grid, uint64_t k, double tolerance) {
+    GAMESOLVER_COUNT(GridPoints, 1);
+    double x = grid.at(k);
+    double value = f(x);
+    int sign = value > tolerance ? 1 : (value < -tolerance ? -1 : 0);
+    return {k, x, value, sign};
+}
+
+// Start a new run of the given sign at x
+inline void enterRun(vector<SignRun>& runs, double x, int sign) {
+    runs.back().hi = x;
+    runs.push_back({x, x, sign});
+}
+
+// Bisect between two samples of different signs down to adjacent grid points,
+// following both halves when the midpoint has the third sign
+template<class Fn>
+void refine(Fn& f, const AdaptiveGrid& grid, double tolerance, const Sample& lo, const Sample& hi,
+            vector<SignRun>& runs) {
+    if (hi.k - lo.k == 1) {
+        if (lo.sign == 0) {
+            enterRun(runs, lo.x, hi.sign);
+        } else if (hi.sign == 0) {
+            enterRun(runs, hi.x, 0);
+        } else {
+            // Strictly positive on one side and negative on the other: interpolate the root
+            double root = lo.x + lo.value / (lo.value - hi.value) * (hi.x - lo.x);
+            enterRun(runs, root, 0);
+            enterRun(runs, root, hi.sign);
+        }
+        return;
+    }
+    Sample mid = sample(f, grid, lo.k + (hi.k - lo.k) / 2, tolerance);
+    if (mid.sign != lo.sign) {
+        refine(f, grid, tolerance, lo, mid, runs);
+    }
+    if (mid.sign != hi.sign) {
+        refine(f, grid, tolerance, mid, hi, runs);
+    }
+}
+
+} // namespace adaptive_grid_detail
+
+// Partition [0, 1] into the runs on which f(x) is positive, negative or zero.
+// A uniform coarse pass finds the cells whose ends differ in sign, and only
+// those are bisected, so each sign change costs O(log(1 / precision))
+// evaluations instead of the O(1 / precision) of a uniform grid. A sign change
+// that starts and ends inside one coarse cell is missed, which cannot happen
+// for a function that is monotone on each coarse cell (such as a linear one).
+template<class Fn>
+vector<SignRun> findSignRuns(Fn f, const GridSearchOptions& options = GridSearchOptions()) {
+    using namespace adaptive_grid_detail;
+    AdaptiveGrid grid(options);
+    double tolerance = options.tolerance;
+    
+    Sample prev = sample(f, grid, 0, tolerance);
+    vector<SignRun> runs = {{0.0, 0.0, prev.sign}};
+    for (uint64_t k = grid.coarseStep(); k <= grid.numPoints(); k += grid.coarseStep()) {
+        Sample next = sample(f, grid, k, tolerance);
+        if (next.sign != prev.sign) {
+            refine(f, grid, tolerance, prev, next, runs);
+        }
+        prev = next;
+    }
+    runs.back().hi = 1.0;
+    return runs;
+}
+
+// Signs accepted by signHull
+enum SignSet : int {
+    SIGN_NEGATIVE = 1,
+    SIGN_ZERO = 2,
+    SIGN_POSITIVE = 4
+};
+
+// Smallest range covering the runs whose sign is in accepted_signs, a mask of
+// SignSet values; lo > hi when there are none
+inline SignRun signHull(const vector<SignRun>& runs, int accepted_signs) {
+    SignRun hull = {1.0, 0.0, 0};
+    for (const SignRun& run : runs) {
+        if (accepted_signs & (1 << (run.sign + 1))) {
+            hull.lo = min(hull.lo, run.lo);
+            hull.hi = max(hull.hi, run.hi);
+        }
+    }
+    return hull;
+}
+
+#endif // ADAPTIVE_GRID_H
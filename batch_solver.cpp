@@ -0,0 +1,286 @@
+#include "batch_solver.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_SOLVER_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Solve games [0, count) of the given streams
+// The outputs include uint8_t arrays, which may alias anything, so every
+// stream is passed as a __restrict parameter to let the loop vectorize.
+static size_t solveStreams(const double* __restrict a00, const double* __restrict a01,
+                           const double* __restrict a10, const double* __restrict a11,
+                           const double* __restrict b00, const double* __restrict b01,
+                           const double* __restrict b10, const double* __restrict b11,
+                           uint8_t* __restrict pure_mask, uint8_t* __restrict num_equilibria,
+                           uint8_t* __restrict flags, double* __restrict mixed_p1,
+                           double* __restrict mixed_p2, size_t count) {
+    size_t degenerate = 0;
+    
+    for (size_t g = 0; g < count; g++) {
+        Solution2x2 s = solveGame2x2(a00[g], a01[g], a10[g], a11[g], b00[g], b01[g], b10[g], b11[g]);
+        pure_mask[g] = s.pure_mask;
+        num_equilibria[g] = s.num_equilibria;
+        flags[g] = s.flags;
+        mixed_p1[g] = s.mixed_p1;
+        mixed_p2[g] = s.mixed_p2;
+        degenerate += (s.flags & BATCH_DEGENERATE) != 0;
+    }
+    
+    return degenerate;
+}
+
+#ifdef BATCH_SOLVER_X86
+
+// Store the low byte of each 64-bit lane
+__attribute__((target("avx2")))
+static inline void storeLowBytes4(__m256i v, uint8_t* out) {
+    const __m256i gather = _mm256_setr_epi8(0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                            0, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i packed = _mm256_shuffle_epi8(v, gather);
+    uint32_t lo = (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(packed)) & 0xFFFF;
+    uint32_t hi = (uint32_t)_mm_cvtsi128_si32(_mm256_extracti128_si256(packed, 1)) & 0xFFFF;
+    uint32_t bytes = lo | (hi << 16);
+    memcpy(out, &bytes, 4);
+}
+
+// Select `bit` in lanes where the comparison mask is set
+__attribute__((target("avx2")))
+static inline __m256i maskBit4(__m256d mask, int64_t bit) {
+    return _mm256_and_si256(_mm256_castpd_si256(mask), _mm256_set1_epi64x(bit));
+}
+
+// AVX2 kernel: 4 games per iteration, scalar tail
+__attribute__((target("avx2")))
+static size_t solveStreamsAVX2(const double* __restrict a00, const double* __restrict a01,
+                               const double* __restrict a10, const double* __restrict a11,
+                               const double* __restrict b00, const double* __restrict b01,
+                               const double* __restrict b10, const double* __restrict b11,
+                               uint8_t* __restrict pure_mask, uint8_t* __restrict num_equilibria,
+                               uint8_t* __restrict flags, double* __restrict mixed_p1,
+                               double* __restrict mixed_p2, size_t count) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d nan = _mm256_set1_pd(numeric_limits<double>::quiet_NaN());
+    size_t degenerate = 0;
+    size_t g = 0;
+    
+    for (; g + 4 <= count; g += 4) {
+        __m256d d1_col1 = _mm256_sub_pd(_mm256_loadu_pd(a00 + g), _mm256_loadu_pd(a10 + g));
+        __m256d d1_col2 = _mm256_sub_pd(_mm256_loadu_pd(a01 + g), _mm256_loadu_pd(a11 + g));
+        __m256d d2_row1 = _mm256_sub_pd(_mm256_loadu_pd(b00 + g), _mm256_loadu_pd(b01 + g));
+        __m256d d2_row2 = _mm256_sub_pd(_mm256_loadu_pd(b10 + g), _mm256_loadu_pd(b11 + g));
+        
+        __m256d ne00 = _mm256_and_pd(_mm256_cmp_pd(d1_col1, zero, _CMP_GE_OQ), _mm256_cmp_pd(d2_row1, zero, _CMP_GE_OQ));
+        __m256d ne01 = _mm256_and_pd(_mm256_cmp_pd(d1_col2, zero, _CMP_GE_OQ), _mm256_cmp_pd(d2_row1, zero, _CMP_LE_OQ));
+        __m256d ne10 = _mm256_and_pd(_mm256_cmp_pd(d1_col1, zero, _CMP_LE_OQ), _mm256_cmp_pd(d2_row2, zero, _CMP_GE_OQ));
+        __m256d ne11 = _mm256_and_pd(_mm256_cmp_pd(d1_col2, zero, _CMP_LE_OQ), _mm256_cmp_pd(d2_row2, zero, _CMP_LE_OQ));
+        
+        __m256d p1_crosses = _mm256_or_pd(
+            _mm256_and_pd(_mm256_cmp_pd(d1_col1, zero, _CMP_GT_OQ), _mm256_cmp_pd(d1_col2, zero, _CMP_LT_OQ)),
+            _mm256_and_pd(_mm256_cmp_pd(d1_col1, zero, _CMP_LT_OQ), _mm256_cmp_pd(d1_col2, zero, _CMP_GT_OQ)));
+        __m256d p2_crosses = _mm256_or_pd(
+            _mm256_and_pd(_mm256_cmp_pd(d2_row1, zero, _CMP_GT_OQ), _mm256_cmp_pd(d2_row2, zero, _CMP_LT_OQ)),
+            _mm256_and_pd(_mm256_cmp_pd(d2_row1, zero, _CMP_LT_OQ), _mm256_cmp_pd(d2_row2, zero, _CMP_GT_OQ)));
+        __m256d has_mixed = _mm256_and_pd(p1_crosses, p2_crosses);
+        __m256d degen = _mm256_or_pd(
+            _mm256_or_pd(_mm256_cmp_pd(d1_col1, zero, _CMP_EQ_OQ), _mm256_cmp_pd(d1_col2, zero, _CMP_EQ_OQ)),
+            _mm256_or_pd(_mm256_cmp_pd(d2_row1, zero, _CMP_EQ_OQ), _mm256_cmp_pd(d2_row2, zero, _CMP_EQ_OQ)));
+        
+        __m256d p1 = _mm256_div_pd(d2_row2, _mm256_sub_pd(d2_row2, d2_row1));
+        __m256d p2 = _mm256_div_pd(d1_col2, _mm256_sub_pd(d1_col2, d1_col1));
+        _mm256_storeu_pd(mixed_p1 + g, _mm256_blendv_pd(nan, p1, has_mixed));
+        _mm256_storeu_pd(mixed_p2 + g, _mm256_blendv_pd(nan, p2, has_mixed));
+        
+        __m256i mask = _mm256_or_si256(_mm256_or_si256(maskBit4(ne00, 1), maskBit4(ne01, 2)),
+                                       _mm256_or_si256(maskBit4(ne10, 4), maskBit4(ne11, 8)));
+        __m256i num = _mm256_add_epi64(_mm256_add_epi64(maskBit4(ne00, 1), maskBit4(ne01, 1)),
+                                       _mm256_add_epi64(_mm256_add_epi64(maskBit4(ne10, 1), maskBit4(ne11, 1)),
+                                                        maskBit4(has_mixed, 1)));
+        __m256i flag = _mm256_or_si256(maskBit4(has_mixed, BATCH_HAS_MIXED), maskBit4(degen, BATCH_DEGENERATE));
+        storeLowBytes4(mask, pure_mask + g);
+        storeLowBytes4(num, num_equilibria + g);
+        storeLowBytes4(flag, flags + g);
+        degenerate += __builtin_popcount(_mm256_movemask_pd(degen));
+    }
+    
+    for (; g < count; g++) {
+        Solution2x2 s = solveGame2x2(a00[g], a01[g], a10[g], a11[g], b00[g], b01[g], b10[g], b11[g]);
+        pure_mask[g] = s.pure_mask;
+        num_equilibria[g] = s.num_equilibria;
+        flags[g] = s.flags;
+        mixed_p1[g] = s.mixed_p1;
+        mixed_p2[g] = s.mixed_p2;
+        degenerate += (s.flags & BATCH_DEGENERATE) != 0;
+    }
+    
+    return degenerate;
+}
+
+// AVX-512 kernel: 8 games per iteration using comparison mask registers, scalar tail
+__attribute__((target("avx512f")))
+static size_t solveStreamsAVX512(const double* __restrict a00, const double* __restrict a01,
+                                 const double* __restrict a10, const double* __restrict a11,
+                                 const double* __restrict b00, const double* __restrict b01,
+                                 const double* __restrict b10, const double* __restrict b11,
+                                 uint8_t* __restrict pure_mask, uint8_t* __restrict num_equilibria,
+                                 uint8_t* __restrict flags, double* __restrict mixed_p1,
+                                 double* __restrict mixed_p2, size_t count) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d nan = _mm512_set1_pd(numeric_limits<double>::quiet_NaN());
+    const __m512i one = _mm512_set1_epi64(1);
+    size_t degenerate = 0;
+    size_t g = 0;
+    
+    for (; g + 8 <= count; g += 8) {
+        __m512d d1_col1 = _mm512_sub_pd(_mm512_loadu_pd(a00 + g), _mm512_loadu_pd(a10 + g));
+        __m512d d1_col2 = _mm512_sub_pd(_mm512_loadu_pd(a01 + g), _mm512_loadu_pd(a11 + g));
+        __m512d d2_row1 = _mm512_sub_pd(_mm512_loadu_pd(b00 + g), _mm512_loadu_pd(b01 + g));
+        __m512d d2_row2 = _mm512_sub_pd(_mm512_loadu_pd(b10 + g), _mm512_loadu_pd(b11 + g));
+        
+        __mmask8 d1_col1_ge = _mm512_cmp_pd_mask(d1_col1, zero, _CMP_GE_OQ);
+        __mmask8 d1_col1_le = _mm512_cmp_pd_mask(d1_col1, zero, _CMP_LE_OQ);
+        __mmask8 d1_col2_ge = _mm512_cmp_pd_mask(d1_col2, zero, _CMP_GE_OQ);
+        __mmask8 d1_col2_le = _mm512_cmp_pd_mask(d1_col2, zero, _CMP_LE_OQ);
+        __mmask8 d2_row1_ge = _mm512_cmp_pd_mask(d2_row1, zero, _CMP_GE_OQ);
+        __mmask8 d2_row1_le = _mm512_cmp_pd_mask(d2_row1, zero, _CMP_LE_OQ);
+        __mmask8 d2_row2_ge = _mm512_cmp_pd_mask(d2_row2, zero, _CMP_GE_OQ);
+        __mmask8 d2_row2_le = _mm512_cmp_pd_mask(d2_row2, zero, _CMP_LE_OQ);
+        
+        __mmask8 ne00 = d1_col1_ge & d2_row1_ge;
+        __mmask8 ne01 = d1_col2_ge & d2_row1_le;
+        __mmask8 ne10 = d1_col1_le & d2_row2_ge;
+        __mmask8 ne11 = d1_col2_le & d2_row2_le;
+        
+        __mmask8 p1_crosses = (_mm512_cmp_pd_mask(d1_col1, zero, _CMP_GT_OQ) & _mm512_cmp_pd_mask(d1_col2, zero, _CMP_LT_OQ)) |
+                              (_mm512_cmp_pd_mask(d1_col1, zero, _CMP_LT_OQ) & _mm512_cmp_pd_mask(d1_col2, zero, _CMP_GT_OQ));
+        __mmask8 p2_crosses = (_mm512_cmp_pd_mask(d2_row1, zero, _CMP_GT_OQ) & _mm512_cmp_pd_mask(d2_row2, zero, _CMP_LT_OQ)) |
+                              (_mm512_cmp_pd_mask(d2_row1, zero, _CMP_LT_OQ) & _mm512_cmp_pd_mask(d2_row2, zero, _CMP_GT_OQ));
+        __mmask8 has_mixed = p1_crosses & p2_crosses;
+        __mmask8 degen = _mm512_cmp_pd_mask(d1_col1, zero, _CMP_EQ_OQ) | _mm512_cmp_pd_mask(d1_col2, zero, _CMP_EQ_OQ) |
+                         _mm512_cmp_pd_mask(d2_row1, zero, _CMP_EQ_OQ) | _mm512_cmp_pd_mask(d2_row2, zero, _CMP_EQ_OQ);
+        
+        __m512d p1 = _mm512_div_pd(d2_row2, _mm512_sub_pd(d2_row2, d2_row1));
+        __m512d p2 = _mm512_div_pd(d1_col2, _mm512_sub_pd(d1_col2, d1_col1));
+        _mm512_storeu_pd(mixed_p1 + g, _mm512_mask_blend_pd(has_mixed, nan, p1));
+        _mm512_storeu_pd(mixed_p2 + g, _mm512_mask_blend_pd(has_mixed, nan, p2));
+        
+        __m512i bit00 = _mm512_maskz_mov_epi64(ne00, one);
+        __m512i bit01 = _mm512_maskz_mov_epi64(ne01, one);
+        __m512i bit10 = _mm512_maskz_mov_epi64(ne10, one);
+        __m512i bit11 = _mm512_maskz_mov_epi64(ne11, one);
+        __m512i mixed_bit = _mm512_maskz_mov_epi64(has_mixed, one);
+        __m512i mask = _mm512_or_si512(_mm512_or_si512(bit00, _mm512_maskz_mov_epi64(ne01, _mm512_set1_epi64(2))),
+                                       _mm512_or_si512(_mm512_maskz_mov_epi64(ne10, _mm512_set1_epi64(4)),
+                                                       _mm512_maskz_mov_epi64(ne11, _mm512_set1_epi64(8))));
+        __m512i num = _mm512_add_epi64(_mm512_add_epi64(bit00, bit01),
+                                       _mm512_add_epi64(_mm512_add_epi64(bit10, bit11), mixed_bit));
+        __m512i flag = _mm512_or_si512(_mm512_maskz_mov_epi64(has_mixed, _mm512_set1_epi64(BATCH_HAS_MIXED)),
+                                       _mm512_maskz_mov_epi64(degen, _mm512_set1_epi64(BATCH_DEGENERATE)));
+        _mm512_mask_cvtepi64_storeu_epi8(pure_mask + g, 0xFF, mask);
+        _mm512_mask_cvtepi64_storeu_epi8(num_equilibria + g, 0xFF, num);
+        _mm512_mask_cvtepi64_storeu_epi8(flags + g, 0xFF, flag);
+        degenerate += __builtin_popcount(degen);
+    }
+    
+    for (; g < count; g++) {
+        Solution2x2 s = solveGame2x2(a00[g], a01[g], a10[g], a11[g], b00[g], b01[g], b10[g], b11[g]);
+        pure_mask[g] = s.pure_mask;
+        num_equilibria[g] = s.num_equilibria;
+        flags[g] = s.flags;
+        mixed_p1[g] = s.mixed_p1;
+        mixed_p2[g] = s.mixed_p2;
+        degenerate += (s.flags & BATCH_DEGENERATE) != 0;
+    }
+    
+    return degenerate;
+}
+
+#endif // BATCH_SOLVER_X86
+
+// Best kernel supported by the running CPU
+BatchKernel detectBatchKernel() {
+#ifdef BATCH_SOLVER_X86
+    static const BatchKernel detected = __builtin_cpu_supports("avx512f") ? BatchKernel::AVX512
+                                      : __builtin_cpu_supports("avx2") ? BatchKernel::AVX2
+                                      : BatchKernel::Scalar;
+    return detected;
+#else
+    return BatchKernel::Scalar;
+#endif
+}
+
+// Human-readable kernel name
+const char* batchKernelName(BatchKernel kernel) {
+    switch (kernel) {
+        case BatchKernel::AVX2: return "avx2";
+        case BatchKernel::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+// Solve every game in the batch
+size_t solveBatch2x2(const BatchGames2x2& games, const BatchResults2x2& results) {
+    return solveBatch2x2(games, results, detectBatchKernel());
+}
+
+// Solve every game in the batch with an explicit kernel
+size_t solveBatch2x2(const BatchGames2x2& games, const BatchResults2x2& results, BatchKernel kernel) {
+    // Never run a kernel the CPU lacks; AVX2 is implied by AVX-512
+    BatchKernel best = detectBatchKernel();
+    if (kernel > best) {
+        kernel = best;
+    }
+    
+#ifdef BATCH_SOLVER_X86
+    if (kernel == BatchKernel::AVX512) {
+        return solveStreamsAVX512(games.a00, games.a01, games.a10, games.a11,
+                                  games.b00, games.b01, games.b10, games.b11,
+                                  results.pure_mask, results.num_equilibria, results.flags,
+                                  results.mixed_p1, results.mixed_p2, games.count);
+    }
+    if (kernel == BatchKernel::AVX2) {
+        return solveStreamsAVX2(games.a00, games.a01, games.a10, games.a11,
+                                games.b00, games.b01, games.b10, games.b11,
+                                results.pure_mask, results.num_equilibria, results.flags,
+                                results.mixed_p1, results.mixed_p2, games.count);
+    }
+#endif
+    return solveStreams(games.a00, games.a01, games.a10, games.a11,
+                        games.b00, games.b01, games.b10, games.b11,
+                        results.pure_mask, results.num_equilibria, results.flags,
+                        results.mixed_p1, results.mixed_p2, games.count);
+}
+
+size_t solveBatch2x2Interleaved(const double* payoffs, size_t count, const BatchResults2x2& results) {
+    return solveBatch2x2Interleaved(payoffs, count, results, detectBatchKernel());
+}
+
+size_t solveBatch2x2Interleaved(const double* payoffs, size_t count, const BatchResults2x2& results,
+                                BatchKernel kernel) {
+    // Blocks small enough for the transposed streams to stay in L1
+    const size_t block = 256;
+    alignas(64) double streams[8][block];
+    
+    size_t degenerate = 0;
+    for (size_t begin = 0; begin < count; begin += block) {
+        size_t n = min(block, count - begin);
+        const double* src = payoffs + begin * 8;
+        for (size_t g = 0; g < n; g++) {
+            for (int k = 0; k < 8; k++) {
+                streams[k][g] = src[g * 8 + k];
+            }
+        }
+        
+        // Each game is stored as a00 b00 a01 b01 a10 b10 a11 b11
+        BatchGames2x2 games = {streams[0], streams[2], streams[4], streams[6],
+                               streams[1], streams[3], streams[5], streams[7], n};
+        BatchResults2x2 out = {results.pure_mask + begin, results.num_equilibria + begin, results.flags + begin,
+                               results.mixed_p1 + begin, results.mixed_p2 + begin};
+        degenerate += solveBatch2x2(games, out, kernel);
+    }
+    return degenerate;
+}
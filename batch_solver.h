@@ -0,0 +1,118 @@
+#ifndef BATCH_SOLVER_H
+#define BATCH_SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+using namespace std;
+
+// Structure-of-arrays view of a batch of 2x2 games. aRC is player 1's payoff
+// and bRC player 2's payoff when player 1 plays row R and player 2 plays column C.
+// Each pointer addresses `count` doubles.
+struct BatchGames2x2 {
+    const double* a00;
+    const double* a01;
+    const double* a10;
+    const double* a11;
+    const double* b00;
+    const double* b01;
+    const double* b10;
+    const double* b11;
+    size_t count;
+};
+
+// Per-game flags written by solveBatch2x2
+enum BatchFlags : uint8_t {
+    BATCH_HAS_MIXED = 1,  // A strictly mixed equilibrium exists (mixed_p1/mixed_p2 are valid)
+    BATCH_DEGENERATE = 2  // A player is indifferent against some pure strategy; the equilibrium
+                          // set may contain a continuum, use NormalFormSolver for the full set
+};
+
+// Caller-allocated output arrays, each holding `count` entries
+struct BatchResults2x2 {
+    uint8_t* pure_mask;      // Bit (row * 2 + col) set when (row, col) is a pure NE
+    uint8_t* num_equilibria; // Number of isolated equilibria (pure + mixed)
+    uint8_t* flags;          // BatchFlags
+    double* mixed_p1;        // Player 1's probability of strategy 1 in the mixed NE, NaN if none
+    double* mixed_p2;        // Player 2's probability of strategy 1 in the mixed NE, NaN if none
+};
+
+// Result of solving a single 2x2 game
+struct Solution2x2 {
+    uint8_t pure_mask;
+    uint8_t num_equilibria;
+    uint8_t flags;
+    double mixed_p1;
+    double mixed_p2;
+};
+
+// Solve one 2x2 game in constant time without branching on the payoffs.
+// Pure equilibria use the same weak inequalities as NormalFormSolver, and the
+// mixed equilibrium is the root of each player's indifference equation.
+inline Solution2x2 solveGame2x2(double a00, double a01, double a10, double a11,
+                                double b00, double b01, double b10, double b11) {
+    // Player 1's gain from row 1 over row 2 against each column,
+    // and player 2's gain from column 1 over column 2 against each row
+    double d1_col1 = a00 - a10;
+    double d1_col2 = a01 - a11;
+    double d2_row1 = b00 - b01;
+    double d2_row2 = b10 - b11;
+    
+    bool ne00 = (d1_col1 >= 0.0) & (d2_row1 >= 0.0);
+    bool ne01 = (d1_col2 >= 0.0) & (d2_row1 <= 0.0);
+    bool ne10 = (d1_col1 <= 0.0) & (d2_row2 >= 0.0);
+    bool ne11 = (d1_col2 <= 0.0) & (d2_row2 <= 0.0);
+    
+    Solution2x2 s;
+    s.pure_mask = (uint8_t)(ne00 | (ne01 << 1) | (ne10 << 2) | (ne11 << 3));
+    
+    // Strictly mixed equilibrium when both gains change sign across the opponent's strategies
+    bool p1_crosses = ((d1_col1 > 0.0) & (d1_col2 < 0.0)) | ((d1_col1 < 0.0) & (d1_col2 > 0.0));
+    bool p2_crosses = ((d2_row1 > 0.0) & (d2_row2 < 0.0)) | ((d2_row1 < 0.0) & (d2_row2 > 0.0));
+    bool has_mixed = p1_crosses & p2_crosses;
+    bool degenerate = (d1_col1 == 0.0) | (d1_col2 == 0.0) | (d2_row1 == 0.0) | (d2_row2 == 0.0);
+    
+    double nan = numeric_limits<double>::quiet_NaN();
+    double p1 = d2_row2 / (d2_row2 - d2_row1);
+    double p2 = d1_col2 / (d1_col2 - d1_col1);
+    s.mixed_p1 = has_mixed ? p1 : nan;
+    s.mixed_p2 = has_mixed ? p2 : nan;
+    s.flags = (uint8_t)((has_mixed ? BATCH_HAS_MIXED : 0) | (degenerate ? BATCH_DEGENERATE : 0));
+    s.num_equilibria = (uint8_t)(ne00 + ne01 + ne10 + ne11 + has_mixed);
+    return s;
+}
+
+// Instruction set used by the batch kernel. All kernels produce bit-identical results.
+enum class BatchKernel {
+    Scalar, // Portable C++ (auto-vectorized where the compiler can)
+    AVX2,   // 4 games per instruction
+    AVX512  // 8 games per instruction
+};
+
+// Best kernel supported by the running CPU
+BatchKernel detectBatchKernel();
+
+// Human-readable kernel name
+const char* batchKernelName(BatchKernel kernel);
+
+// Solve every game in the batch, writing into the preallocated result arrays.
+// Performs no allocation and no formatting. Returns the number of degenerate games.
+// Uses the best kernel for the running CPU.
+size_t solveBatch2x2(const BatchGames2x2& games, const BatchResults2x2& results);
+
+// Same as above with an explicit kernel; a kernel the CPU lacks falls back to detectBatchKernel()
+size_t solveBatch2x2(const BatchGames2x2& games, const BatchResults2x2& results, BatchKernel kernel);
+
+// Solve `count` games stored back to back in Game2x2 order [row][col][player],
+// 8 doubles per game (the interleaved layout of game files). Games are transposed
+// a block at a time into stack buffers and solved with the SoA kernels, so the
+// results equal those of solveBatch2x2. Performs no allocation.
+// Returns the number of degenerate games.
+size_t solveBatch2x2Interleaved(const double* payoffs, size_t count, const BatchResults2x2& results);
+
+// Same as above with an explicit kernel
+size_t solveBatch2x2Interleaved(const double* payoffs, size_t count, const BatchResults2x2& results,
+                                BatchKernel kernel);
+
+#endif // BATCH_SOLVER_H
@@ -0,0 +1,619 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "game_solver.h"
+#include "game_3x3.h"
+#include "game_session.h"
+#include "equilibrium_cache.h"
+#include "parametric_sweep.h"
+#include "batch_solver.h"
+#include "nplayer_game.h"
+#include "pure_nash.h"
+#include "compressed_game.h"
+
+using namespace std;
+
+// Microbenchmarks of the solver entry points on corpora of random, degenerate
+// and classic games. The harness follows Google Benchmark: each benchmark runs
+// in growing batches until it has used --benchmark_min_time seconds, and the
+// results are printed as a table or as Google Benchmark JSON
+// (--benchmark_format=json, --benchmark_out=FILE), so the usual comparison
+// tools can diff two runs.
+
+// Forwarders to the private stages of NormalFormSolver
+struct NormalFormSolverAccess {
+    static vector<Equilibrium> findPureNashEquilibria(const NormalFormSolver& s) {
+        return s.findPureNashEquilibria();
+    }
+    static vector<Equilibrium> findMixedNashEquilibria(const NormalFormSolver& s) {
+        return s.findMixedNashEquilibria();
+    }
+    static vector<Equilibrium> findMixedNashEquilibriaAnalytic(const NormalFormSolver& s) {
+        return s.findMixedNashEquilibriaAnalytic();
+    }
+    static double findBestResponse(const NormalFormSolver& s, int player, double other_player_prob) {
+        return s.findBestResponse(player, other_player_prob);
+    }
+};
+
+// Keep the compiler from discarding a computed value
+template<class T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Number of games in each generated corpus
+const size_t CORPUS_SIZE = 4096;
+
+// Fill a game with payoffs drawn by next()
+template<class GameT>
+static GameT makeGame(const function<double()>& next) {
+    GameT game;
+    for (int i = 0; i < game.rows(); i++) {
+        for (int j = 0; j < game.cols(); j++) {
+            game.setPayoff(i, j, 0, next());
+            game.setPayoff(i, j, 1, next());
+        }
+    }
+    return game;
+}
+
+// Build a 2x2 game from payoffs in [row][col][player] order
+static Game2x2 game2x2(const array<double, 8>& payoffs) {
+    Game2x2 game;
+    copy(payoffs.begin(), payoffs.end(), game.payoffs.begin());
+    return game;
+}
+
+// Random continuous payoffs: almost surely nondegenerate
+template<class GameT>
+static vector<GameT> randomCorpus(uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> payoff(-10.0, 10.0);
+    vector<GameT> corpus;
+    for (size_t g = 0; g < CORPUS_SIZE; g++) {
+        corpus.push_back(makeGame<GameT>([&] { return payoff(rng); }));
+    }
+    return corpus;
+}
+
+// Payoffs from {0, 1, 2}: many ties, continua and weakly dominated strategies
+template<class GameT>
+static vector<GameT> degenerateCorpus(uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> payoff(0, 2);
+    vector<GameT> corpus;
+    for (size_t g = 0; g < CORPUS_SIZE; g++) {
+        corpus.push_back(makeGame<GameT>([&] { return (double)payoff(rng); }));
+    }
+    return corpus;
+}
+
+// Textbook 2x2 games, repeated to the corpus size
+static vector<Game2x2> classicCorpus2x2() {
+    const vector<array<double, 8>> classics = {
+        {3, 3, 0, 5, 5, 0, 1, 1},     // Prisoner's Dilemma
+        {3, 2, 0, 0, 0, 0, 2, 3},     // Battle of the Sexes
+        {2, 2, 0, 0, 0, 0, 1, 1},     // Coordination
+        {1, -1, -1, 1, -1, 1, 1, -1}, // Matching Pennies
+        {0, 0, -1, 1, 1, -1, -5, -5}, // Chicken
+        {4, 4, 0, 3, 3, 0, 3, 3}      // Stag Hunt
+    };
+    vector<Game2x2> corpus;
+    for (size_t g = 0; g < CORPUS_SIZE; g++) {
+        corpus.push_back(game2x2(classics[g % classics.size()]));
+    }
+    return corpus;
+}
+
+// Textbook 3x3 games, repeated to the corpus size
+static vector<Game3x3> classicCorpus3x3() {
+    const vector<array<double, 18>> classics = {
+        {0, 0, -1, 1, 1, -1, 1, -1, 0, 0, -1, 1, -1, 1, 1, -1, 0, 0}, // Rock-Paper-Scissors
+        {3, 3, 0, 5, 2, 1, 5, 0, 1, 1, 4, 2, 1, 2, 2, 4, 6, 6},       // Extended Coordination (3x3 example)
+        {2, 2, 0, 0, 0, 0, 0, 0, 2, 2, 0, 0, 0, 0, 0, 0, 2, 2},       // Pure coordination
+        {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}        // Mostly zero (degenerate)
+    };
+    vector<Game3x3> corpus;
+    for (size_t g = 0; g < CORPUS_SIZE; g++) {
+        Game3x3 game;
+        const auto& payoffs = classics[g % classics.size()];
+        copy(payoffs.begin(), payoffs.end(), game.payoffs.begin());
+        corpus.push_back(game);
+    }
+    return corpus;
+}
+
+// One measured benchmark
+struct BenchmarkResult {
+    string name;
+    size_t iterations;
+    double real_ns; // Wall time per game
+    double cpu_ns;  // CPU time per game
+};
+
+static double cpuSeconds() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Benchmark registry and runner
+class BenchmarkRunner {
+private:
+    // body(i) processes game i of a corpus; one call is one iteration
+    struct Benchmark {
+        string name;
+        function<void(size_t)> body;
+    };
+    
+    vector<Benchmark> benchmarks;
+    double min_time;
+    string filter;
+
+public:
+    BenchmarkRunner() : min_time(0.5) {}
+    
+    void setMinTime(double seconds) { min_time = seconds; }
+    void setFilter(const string& f) { filter = f; }
+    
+    void add(const string& name, const function<void(size_t)>& body) {
+        benchmarks.push_back({name, body});
+    }
+    
+    // Run every benchmark whose name contains the filter
+    vector<BenchmarkResult> run(bool progress) const {
+        vector<BenchmarkResult> results;
+        for (const auto& bench : benchmarks) {
+            if (!filter.empty() && bench.name.find(filter) == string::npos) {
+                continue;
+            }
+            
+            // Grow the iteration count until one batch takes min_time
+            size_t iterations = 1;
+            double real = 0.0;
+            double cpu = 0.0;
+            while (true) {
+                auto start = chrono::steady_clock::now();
+                double cpu_start = cpuSeconds();
+                for (size_t i = 0; i < iterations; i++) {
+                    bench.body(i);
+                }
+                cpu = cpuSeconds() - cpu_start;
+                real = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                if (real >= min_time || iterations >= ((size_t)1 << 40)) {
+                    break;
+                }
+                double scale = real > 0.0 ? min_time * 1.4 / real : 10.0;
+                iterations = (size_t)(iterations * min(10.0, max(2.0, scale)));
+            }
+            
+            BenchmarkResult result = {bench.name, iterations, real * 1e9 / iterations, cpu * 1e9 / iterations};
+            results.push_back(result);
+            if (progress) {
+                printf("%-64s %12.1f ns %12.1f ns %12zu  games/s=%.4g\n", result.name.c_str(),
+                       result.real_ns, result.cpu_ns, result.iterations, 1e9 / result.real_ns);
+                fflush(stdout);
+            }
+        }
+        return results;
+    }
+};
+
+// Escape a string for JSON
+static string jsonString(const string& s) {
+    string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+// Results in Google Benchmark's JSON format
+static string toJson(const vector<BenchmarkResult>& results) {
+    ostringstream out;
+    char date[64];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": " << jsonString(date) << ",\n";
+    out << "    \"executable\": \"bench_games\",\n";
+    out << "    \"num_cpus\": " << thread::hardware_concurrency() << ",\n";
+    out << "    \"batch_kernel\": " << jsonString(batchKernelName(detectBatchKernel())) << ",\n";
+#ifdef NDEBUG
+    out << "    \"library_build_type\": \"release\"\n";
+#else
+    out << "    \"library_build_type\": \"debug\"\n";
+#endif
+    out << "  },\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& r = results[i];
+        out << "    {\n";
+        out << "      \"name\": " << jsonString(r.name) << ",\n";
+        out << "      \"run_name\": " << jsonString(r.name) << ",\n";
+        out << "      \"run_type\": \"iteration\",\n";
+        out << "      \"iterations\": " << r.iterations << ",\n";
+        out << "      \"real_time\": " << setprecision(10) << r.real_ns << ",\n";
+        out << "      \"cpu_time\": " << r.cpu_ns << ",\n";
+        out << "      \"time_unit\": \"ns\",\n";
+        out << "      \"items_per_second\": " << 1e9 / r.real_ns << "\n";
+        out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+// Register the 2x2 benchmarks for one corpus
+static void add2x2Benchmarks(BenchmarkRunner& runner, const string& corpus_name,
+                             const vector<Game2x2>& games, const vector<NormalFormSolver>& solvers) {
+    const size_t mask = CORPUS_SIZE - 1;
+    
+    runner.add("NormalFormSolver::NormalFormSolver/" + corpus_name, [&games, mask](size_t i) {
+        NormalFormSolver solver(games[i & mask]);
+        doNotOptimize(solver);
+    });
+    runner.add("NormalFormSolver::findPureNashEquilibria/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = NormalFormSolverAccess::findPureNashEquilibria(solvers[i & mask]);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findMixedNashEquilibria/grid/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = NormalFormSolverAccess::findMixedNashEquilibria(solvers[i & mask]);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findMixedNashEquilibria/analytic/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = NormalFormSolverAccess::findMixedNashEquilibriaAnalytic(solvers[i & mask]);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findAllNashEquilibria/analytic/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = solvers[i & mask].findAllNashEquilibria(SolverMode::Analytic);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findAllNashEquilibria/adaptive/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = solvers[i & mask].findAllNashEquilibria(SolverMode::Adaptive);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findAllNashEquilibria/exact/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = solvers[i & mask].findAllNashEquilibria(SolverMode::Exact);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findNonMyopicEquilibria/grid/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = solvers[i & mask].findNonMyopicEquilibria(SolverMode::Grid);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findNonMyopicEquilibria/analytic/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = solvers[i & mask].findNonMyopicEquilibria(SolverMode::Analytic);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findNonMyopicEquilibria/adaptive/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = solvers[i & mask].findNonMyopicEquilibria(SolverMode::Adaptive);
+        doNotOptimize(eq);
+    });
+    runner.add("NormalFormSolver::findNonMyopicEquilibria/exact/" + corpus_name, [&solvers, mask](size_t i) {
+        vector<Equilibrium> eq = solvers[i & mask].findNonMyopicEquilibria(SolverMode::Exact);
+        doNotOptimize(eq);
+    });
+    // Sweep player 1's payoff at (row 2, column 1), the temptation payoff of the Prisoner's Dilemma
+    runner.add("sweepEquilibria/" + corpus_name, [&games, mask](size_t i) {
+        Game2x2 dt;
+        dt.setPayoff(1, 0, 0, 1.0);
+        ParametricSweep sweep = sweepEquilibria(AffineGame2x2(games[i & mask], dt), -10.0, 10.0);
+        doNotOptimize(sweep);
+    });
+    // Nash and non-myopic equilibria through a canonical-form cache, warm after the first pass
+    auto cache = make_shared<EquilibriumCache2x2>();
+    runner.add("solveCached/" + corpus_name, [&games, mask, cache](size_t i) {
+        GameSolution2x2 solution = solveCached(games[i & mask], *cache);
+        doNotOptimize(solution);
+    });
+    runner.add("NormalFormSolver::findBestResponse/" + corpus_name, [&solvers, mask](size_t i) {
+        double x = (double)(i & 63) / 63.0;
+        double response = NormalFormSolverAccess::findBestResponse(solvers[i & mask], (int)(i & 1), x);
+        doNotOptimize(response);
+    });
+}
+
+// Register the 3x3 benchmarks for one corpus
+static void add3x3Benchmarks(BenchmarkRunner& runner, const string& corpus_name, const vector<Game3x3>& games) {
+    const size_t mask = CORPUS_SIZE - 1;
+    
+    runner.add("Game3x3Solver::extractAll2x2Submatrices/" + corpus_name, [&games, mask](size_t i) {
+        Game3x3Solver solver(games[i & mask]);
+        vector<Submatrix2x2> submatrices = solver.extractAll2x2Submatrices();
+        doNotOptimize(submatrices);
+    });
+    runner.add("Game3x3Solver::calculate3x3NMEFromSubgames/" + corpus_name, [&games, mask](size_t i) {
+        Game3x3Solver solver(games[i & mask]);
+        SubgamePrediction prediction = solver.calculate3x3NMEFromSubgames();
+        doNotOptimize(prediction);
+    });
+    // One payoff edit followed by a new prediction, cycling through the cells
+    auto session = make_shared<GameSession3x3>(games[0]);
+    runner.add("GameSession3x3::setPayoff+calculate3x3NMEFromSubgames/" + corpus_name,
+               [&games, mask, session](size_t i) {
+        int cell = (int)(i % 9);
+        int player = (int)((i / 9) & 1);
+        double payoff = games[i & mask].getPayoffUnchecked(cell / 3, cell % 3, player);
+        session->setPayoff(cell / 3, cell % 3, player, payoff);
+        SubgamePrediction prediction = session->calculate3x3NMEFromSubgames();
+        doNotOptimize(prediction);
+    });
+    runner.add("Game3x3Solver::findPureNashEquilibria/" + corpus_name, [&games, mask](size_t i) {
+        vector<PureProfile> pure = BimatrixSolver<Game3x3>(games[i & mask]).findPureNashEquilibria();
+        doNotOptimize(pure);
+    });
+    runner.add("NashEngine::supportEnumeration/" + corpus_name, [&games, mask](size_t i) {
+        vector<MixedEquilibrium> eq = NashEngine<Game3x3>(games[i & mask]).supportEnumeration();
+        doNotOptimize(eq);
+    });
+    auto cache = make_shared<EquilibriumCache<Game3x3, vector<MixedEquilibrium>>>();
+    runner.add("supportEnumerationCached/" + corpus_name, [&games, mask, cache](size_t i) {
+        vector<MixedEquilibrium> eq = supportEnumerationCached(games[i & mask], *cache);
+        doNotOptimize(eq);
+    });
+}
+
+// Random continuous N-player games with the given strategy counts
+static vector<NPlayerGame> randomNPlayerCorpus(const vector<int>& strategies, uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> payoff(-10.0, 10.0);
+    vector<NPlayerGame> corpus;
+    for (size_t g = 0; g < CORPUS_SIZE; g++) {
+        NPlayerGame game(strategies);
+        for (double& value : game.payoffs) {
+            value = payoff(rng);
+        }
+        corpus.push_back(game);
+    }
+    return corpus;
+}
+
+// Register the N-player benchmarks for one corpus
+static void addNPlayerBenchmarks(BenchmarkRunner& runner, const string& corpus_name,
+                                 const vector<NPlayerGame>& games) {
+    const size_t mask = CORPUS_SIZE - 1;
+    
+    runner.add("NPlayerSolver::findPureNashEquilibria/" + corpus_name, [&games, mask](size_t i) {
+        vector<vector<int>> pure = NPlayerSolver(games[i & mask]).findPureNashEquilibria();
+        doNotOptimize(pure);
+    });
+    // Uniform mixes, so no axis is skipped
+    runner.add("NPlayerSolver::deviationPayoffs/" + corpus_name, [&games, mask](size_t i) {
+        const NPlayerGame& game = games[i & mask];
+        vector<vector<double>> mixes;
+        for (int n : game.num_strategies) {
+            mixes.emplace_back(n, 1.0 / n);
+        }
+        vector<double> payoffs;
+        NPlayerSolver(game).deviationPayoffs(mixes, (int)(i % game.numPlayers()), payoffs);
+        doNotOptimize(payoffs);
+    });
+    runner.add("NPlayerSolver::supportEnumeration/" + corpus_name, [&games, mask](size_t i) {
+        vector<NPlayerEquilibrium> eq = NPlayerSolver(games[i & mask]).supportEnumeration();
+        doNotOptimize(eq);
+    });
+}
+
+// Large games with payoffs from {0, ..., 999}; a few games are cycled, as a
+// full corpus of them would not fit in memory
+static vector<DynamicGame> largeCorpus(int size, size_t count, uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> payoff(0, 999);
+    vector<DynamicGame> corpus;
+    for (size_t g = 0; g < count; g++) {
+        DynamicGame game(size, size);
+        for (double& value : game.payoffs) {
+            value = (double)payoff(rng);
+        }
+        corpus.push_back(game);
+    }
+    return corpus;
+}
+
+// Register the pure equilibrium benchmarks for one corpus of large games
+static void addLargeGameBenchmarks(BenchmarkRunner& runner, const string& corpus_name,
+                                   const vector<DynamicGame>& games) {
+    runner.add("BimatrixSolver::findPureNashEquilibria/" + corpus_name, [&games](size_t i) {
+        vector<PureProfile> pure = BimatrixSolver<DynamicGame>(games[i % games.size()]).findPureNashEquilibria();
+        doNotOptimize(pure);
+    });
+    runner.add("screenPureNashEquilibria/" + corpus_name, [&games](size_t i) {
+        vector<PureProfile> pure = screenPureNashEquilibria(games[i % games.size()]);
+        doNotOptimize(pure);
+    });
+}
+
+// A size x size sparse game whose cells differ from a constant payoff with
+// the given density, and a low-rank game of the same size with random factors
+static SparseGame largeSparseGame(int size, double density, uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> strategy(0, size - 1);
+    uniform_real_distribution<double> payoff(-10.0, 10.0);
+    vector<SparseEntry> entries;
+    size_t count = (size_t)(density * size * size);
+    for (size_t k = 0; k < 2 * count; k++) {
+        entries.push_back({strategy(rng), strategy(rng), (int)(k & 1), payoff(rng)});
+    }
+    SparseGame game;
+    buildSparseGame(size, size, 0.0, 0.0, entries, game);
+    return game;
+}
+
+static LowRankGame largeLowRankGame(int size, int rank, uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> factor(-1.0, 1.0);
+    vector<double> factors[4];
+    for (auto& f : factors) {
+        f.resize((size_t)size * rank);
+        for (double& value : f) {
+            value = factor(rng);
+        }
+    }
+    LowRankGame game;
+    buildLowRankGame(size, size, rank, factors[0], factors[1], rank, factors[2], factors[3], game);
+    return game;
+}
+
+// Register the best response benchmarks for one compressed game; the mixes
+// are uniform, so every entry or factor is used
+template<class GameT>
+static void addCompressedBenchmarks(BenchmarkRunner& runner, const string& name, const GameT& game) {
+    auto mix = make_shared<vector<double>>(game.rows(), 1.0 / game.rows());
+    runner.add("CompressedGameSolver::bestResponseRow/" + name, [&game, mix](size_t) {
+        int best = CompressedGameSolver<GameT>(game).bestResponseRow(mix->data());
+        doNotOptimize(best);
+    });
+    runner.add("CompressedGameSolver::bestResponseCol/" + name, [&game, mix](size_t) {
+        int best = CompressedGameSolver<GameT>(game).bestResponseCol(mix->data());
+        doNotOptimize(best);
+    });
+}
+
+// Structure-of-arrays copy of a 2x2 corpus with its result arrays
+struct BatchCorpus {
+    vector<double> streams[8];
+    vector<uint8_t> pure_mask, num_equilibria, flags;
+    vector<double> mixed_p1, mixed_p2;
+    
+    explicit BatchCorpus(const vector<Game2x2>& games)
+        : pure_mask(games.size()), num_equilibria(games.size()), flags(games.size()),
+          mixed_p1(games.size()), mixed_p2(games.size()) {
+        // Streams in BatchGames2x2 order: a00 a01 a10 a11 b00 b01 b10 b11
+        for (const auto& game : games) {
+            for (int player = 0; player < 2; player++) {
+                for (int cell = 0; cell < 4; cell++) {
+                    streams[player * 4 + cell].push_back(game.getPayoffUnchecked(cell / 2, cell % 2, player));
+                }
+            }
+        }
+    }
+    
+    BatchGames2x2 games() const {
+        return {streams[0].data(), streams[1].data(), streams[2].data(), streams[3].data(),
+                streams[4].data(), streams[5].data(), streams[6].data(), streams[7].data(), streams[0].size()};
+    }
+    
+    BatchResults2x2 results() {
+        return {pure_mask.data(), num_equilibria.data(), flags.data(), mixed_p1.data(), mixed_p2.data()};
+    }
+};
+
+// Register the batch kernel benchmarks for one corpus; one iteration solves one game
+static void addBatchBenchmarks(BenchmarkRunner& runner, const string& corpus_name, BatchCorpus& corpus) {
+    const BatchKernel kernels[] = {BatchKernel::Scalar, BatchKernel::AVX2, BatchKernel::AVX512};
+    for (BatchKernel kernel : kernels) {
+        if (kernel > detectBatchKernel()) {
+            continue;
+        }
+        // Solve the corpus once per CORPUS_SIZE iterations
+        runner.add(string("solveBatch2x2/") + batchKernelName(kernel) + "/" + corpus_name,
+                   [&corpus, kernel](size_t i) {
+            if ((i & (CORPUS_SIZE - 1)) == 0) {
+                size_t degenerate = solveBatch2x2(corpus.games(), corpus.results(), kernel);
+                doNotOptimize(degenerate);
+            }
+        });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner runner;
+    string format = "console";
+    string out_path;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("--benchmark_filter=", 0) == 0) {
+            runner.setFilter(arg.substr(strlen("--benchmark_filter=")));
+        } else if (arg.rfind("--benchmark_min_time=", 0) == 0) {
+            runner.setMinTime(atof(arg.substr(strlen("--benchmark_min_time=")).c_str()));
+        } else if (arg.rfind("--benchmark_format=", 0) == 0) {
+            format = arg.substr(strlen("--benchmark_format="));
+        } else if (arg.rfind("--benchmark_out=", 0) == 0) {
+            out_path = arg.substr(strlen("--benchmark_out="));
+        } else {
+            cerr << "Usage: " << argv[0] << " [--benchmark_filter=SUBSTRING] [--benchmark_min_time=SECONDS]"
+                 << " [--benchmark_format=console|json] [--benchmark_out=FILE]" << endl;
+            return 1;
+        }
+    }
+    
+    // Corpora; CORPUS_SIZE is a power of two so game i is games[i & (CORPUS_SIZE - 1)]
+    vector<pair<string, vector<Game2x2>>> corpora2x2 = {
+        {"random", randomCorpus<Game2x2>(1)},
+        {"degenerate", degenerateCorpus<Game2x2>(2)},
+        {"classic", classicCorpus2x2()}
+    };
+    vector<pair<string, vector<Game3x3>>> corpora3x3 = {
+        {"random", randomCorpus<Game3x3>(3)},
+        {"degenerate", degenerateCorpus<Game3x3>(4)},
+        {"classic", classicCorpus3x3()}
+    };
+    vector<pair<string, vector<NPlayerGame>>> corporaNPlayer = {
+        {"random3x3x3", randomNPlayerCorpus({3, 3, 3}, 5)},
+        {"random2^5", randomNPlayerCorpus({2, 2, 2, 2, 2}, 6)}
+    };
+    vector<pair<string, vector<DynamicGame>>> corporaLarge = {
+        {"random100x100", largeCorpus(100, 16, 7)},
+        {"random1000x1000", largeCorpus(1000, 4, 8)}
+    };
+    SparseGame sparse = largeSparseGame(10000, 0.01, 9);
+    LowRankGame low_rank = largeLowRankGame(10000, 8, 10);
+    vector<vector<NormalFormSolver>> solvers;
+    vector<unique_ptr<BatchCorpus>> batch_corpora;
+    for (const auto& corpus : corpora2x2) {
+        solvers.emplace_back(corpus.second.begin(), corpus.second.end());
+        batch_corpora.emplace_back(new BatchCorpus(corpus.second));
+    }
+    
+    for (size_t c = 0; c < corpora2x2.size(); c++) {
+        add2x2Benchmarks(runner, corpora2x2[c].first, corpora2x2[c].second, solvers[c]);
+        addBatchBenchmarks(runner, corpora2x2[c].first, *batch_corpora[c]);
+    }
+    for (const auto& corpus : corpora3x3) {
+        add3x3Benchmarks(runner, corpus.first, corpus.second);
+    }
+    for (const auto& corpus : corporaNPlayer) {
+        addNPlayerBenchmarks(runner, corpus.first, corpus.second);
+    }
+    for (const auto& corpus : corporaLarge) {
+        addLargeGameBenchmarks(runner, corpus.first, corpus.second);
+    }
+    addCompressedBenchmarks(runner, "sparse10000x10000", sparse);
+    addCompressedBenchmarks(runner, "rank8_10000x10000", low_rank);
+    
+    bool console = format != "json";
+    if (console) {
+        printf("%-64s %15s %15s %12s\n", "Benchmark (per game)", "Time", "CPU", "Iterations");
+        printf("%s\n", string(110, '-').c_str());
+    }
+    vector<BenchmarkResult> results = runner.run(console);
+    
+    string json = toJson(results);
+    if (!console) {
+        fputs(json.c_str(), stdout);
+    }
+    if (!out_path.empty()) {
+        ofstream out(out_path);
+        out << json;
+        if (!out) {
+            cerr << "Cannot write " << out_path << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,333 @@
+#ifndef BIMATRIX_GAME_H
+#define BIMATRIX_GAME_H
+
+#include <iostream>
+#include <array>
+#include <vector>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// Structure to represent an R x C two-player normal form game
+// Payoffs are stored contiguously as [row][col][player]; the dimensions are
+// compile-time constants, so solver loops over them are fully unrolled.
+template<int R, int C>
+struct Game {
+    alignas(64) array<double, 2 * R * C> payoffs; // [row][col][player]
+    
+    Game() {
+        payoffs.fill(0.0);
+    }
+    
+    static constexpr int rows() { return R; }
+    static constexpr int cols() { return C; }
+    
+    // Flat index of a payoff
+    static int index(int row, int col, int player) {
+        return (row * C + col) * 2 + player;
+    }
+    
+    // Set payoff for a specific outcome
+    void setPayoff(int row, int col, int player, double payoff) {
+        if (row >= 0 && row < R && col >= 0 && col < C && player >= 0 && player < 2) {
+            payoffs[index(row, col, player)] = payoff;
+        }
+    }
+    
+    // Get payoff for a specific outcome
+    double getPayoff(int row, int col, int player) const {
+        if (row >= 0 && row < R && col >= 0 && col < C && player >= 0 && player < 2) {
+            return payoffs[index(row, col, player)];
+        }
+        return 0.0;
+    }
+    
+    // Get payoff without bounds checking, for solver inner loops
+    double getPayoffUnchecked(int row, int col, int player) const {
+        return payoffs[index(row, col, player)];
+    }
+    
+    // Print the game matrix
+    void printGame() const {
+        cout << R << "x" << C << " Game Matrix:" << endl;
+        cout << "                    Player 2" << endl;
+        cout << "           ";
+        for (int j = 0; j < C; j++) {
+            cout << " Strategy " << (j+1) << (j < C - 1 ? "   " : "");
+        }
+        cout << endl;
+        
+        for (int i = 0; i < R; i++) {
+            cout << "Player 1 Strategy " << (i+1) << ": ";
+            for (int j = 0; j < C; j++) {
+                cout << "(" << fixed << setprecision(1)
+                     << getPayoff(i, j, 0) << ", " << getPayoff(i, j, 1) << ")";
+                if (j < C - 1) cout << "    ";
+            }
+            cout << endl;
+        }
+        cout << endl;
+    }
+};
+
+// Structure to represent a two-player normal form game whose dimensions are
+// only known at runtime. Same layout and interface as Game<R,C>.
+struct DynamicGame {
+    int num_rows;
+    int num_cols;
+    vector<double> payoffs; // [row][col][player]
+    
+    DynamicGame(int rows = 0, int cols = 0)
+        : num_rows(rows), num_cols(cols), payoffs(2 * rows * cols, 0.0) {}
+    
+    int rows() const { return num_rows; }
+    int cols() const { return num_cols; }
+    
+    // Flat index of a payoff
+    int index(int row, int col, int player) const {
+        return (row * num_cols + col) * 2 + player;
+    }
+    
+    // Set payoff for a specific outcome
+    void setPayoff(int row, int col, int player, double payoff) {
+        if (row >= 0 && row < num_rows && col >= 0 && col < num_cols && player >= 0 && player < 2) {
+            payoffs[index(row, col, player)] = payoff;
+        }
+    }
+    
+    // Get payoff for a specific outcome
+    double getPayoff(int row, int col, int player) const {
+        if (row >= 0 && row < num_rows && col >= 0 && col < num_cols && player >= 0 && player < 2) {
+            return payoffs[index(row, col, player)];
+        }
+        return 0.0;
+    }
+    
+    // Get payoff without bounds checking, for solver inner loops
+    double getPayoffUnchecked(int row, int col, int player) const {
+        return payoffs[index(row, col, player)];
+    }
+};
+
+// Read-only view of a game stored elsewhere in [row][col][player] order,
+// e.g. inside a memory-mapped game file. Same read interface as Game<R,C>,
+// so the templated solvers run on it without copying the payoffs.
+struct GameView {
+    int num_rows;
+    int num_cols;
+    const double* payoffs; // [row][col][player]
+    
+    GameView(int rows = 0, int cols = 0, const double* data = nullptr)
+        : num_rows(rows), num_cols(cols), payoffs(data) {}
+    
+    int rows() const { return num_rows; }
+    int cols() const { return num_cols; }
+    
+    // Flat index of a payoff
+    int index(int row, int col, int player) const {
+        return (row * num_cols + col) * 2 + player;
+    }
+    
+    // Get payoff for a specific outcome
+    double getPayoff(int row, int col, int player) const {
+        if (row >= 0 && row < num_rows && col >= 0 && col < num_cols && player >= 0 && player < 2) {
+            return payoffs[index(row, col, player)];
+        }
+        return 0.0;
+    }
+    
+    // Get payoff without bounds checking, for solver inner loops
+    double getPayoffUnchecked(int row, int col, int player) const {
+        return payoffs[index(row, col, player)];
+    }
+};
+
+// Copy any game into a runtime-sized game
+template<class GameT>
+DynamicGame toDynamicGame(const GameT& game) {
+    DynamicGame result(game.rows(), game.cols());
+    for (int i = 0; i < game.rows(); i++) {
+        for (int j = 0; j < game.cols(); j++) {
+            result.setPayoff(i, j, 0, game.getPayoffUnchecked(i, j, 0));
+            result.setPayoff(i, j, 1, game.getPayoffUnchecked(i, j, 1));
+        }
+    }
+    return result;
+}
+
+// Extract the 2x2 subgame of any game on rows (r1, r2) and columns (c1, c2)
+template<class GameT>
+Game<2, 2> extractSubgame2x2(const GameT& game, int r1, int r2, int c1, int c2) {
+    Game<2, 2> subgame;
+    const int rows[2] = {r1, r2};
+    const int cols[2] = {c1, c2};
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            subgame.setPayoff(i, j, 0, game.getPayoffUnchecked(rows[i], cols[j], 0));
+            subgame.setPayoff(i, j, 1, game.getPayoffUnchecked(rows[i], cols[j], 1));
+        }
+    }
+    return subgame;
+}
+
+// Number of 2x2 subgames (row pair x column pair) of a game
+inline int countSubgames2x2(int rows, int cols) {
+    return (rows * (rows - 1) / 2) * (cols * (cols - 1) / 2);
+}
+
+// Structure to represent a pure strategy profile (row, column)
+struct PureProfile {
+    int row;
+    int col;
+    
+    PureProfile(int r = 0, int c = 0) : row(r), col(c) {}
+};
+
+// Solver for any bimatrix game type exposing rows(), cols() and
+// getPayoffUnchecked(). Instantiated with Game<R,C> the loop bounds are
+// compile-time constants; with DynamicGame they are read at runtime.
+// Mixed strategies are passed as probability arrays of length rows()/cols().
+template<class GameT>
+class BimatrixSolver {
+private:
+    const GameT& game;
+
+public:
+    BimatrixSolver(const GameT& g) : game(g) {}
+    
+    // Expected payoff of each row for player 1 against a column mix
+    void rowPayoffs(const double* col_mix, double* out) const {
+        for (int i = 0; i < game.rows(); i++) {
+            double sum = 0.0;
+            for (int j = 0; j < game.cols(); j++) {
+                sum += col_mix[j] * game.getPayoffUnchecked(i, j, 0);
+            }
+            out[i] = sum;
+        }
+    }
+    
+    // Expected payoff of each column for player 2 against a row mix
+    void colPayoffs(const double* row_mix, double* out) const {
+        for (int j = 0; j < game.cols(); j++) {
+            out[j] = 0.0;
+        }
+        for (int i = 0; i < game.rows(); i++) {
+            for (int j = 0; j < game.cols(); j++) {
+                out[j] += row_mix[i] * game.getPayoffUnchecked(i, j, 1);
+            }
+        }
+    }
+    
+    // Expected payoff for a player under a mixed strategy profile
+    double expectedPayoff(int player, const double* row_mix, const double* col_mix) const {
+        double expected_payoff = 0.0;
+        for (int i = 0; i < game.rows(); i++) {
+            for (int j = 0; j < game.cols(); j++) {
+                expected_payoff += row_mix[i] * col_mix[j] * game.getPayoffUnchecked(i, j, player);
+            }
+        }
+        return expected_payoff;
+    }
+    
+    // Lowest-index pure best response of player 1 to a column mix
+    int bestResponseRow(const double* col_mix) const {
+        int best = 0;
+        double best_payoff = -INFINITY;
+        for (int i = 0; i < game.rows(); i++) {
+            double payoff = 0.0;
+            for (int j = 0; j < game.cols(); j++) {
+                payoff += col_mix[j] * game.getPayoffUnchecked(i, j, 0);
+            }
+            if (payoff > best_payoff) {
+                best_payoff = payoff;
+                best = i;
+            }
+        }
+        return best;
+    }
+    
+    // Lowest-index pure best response of player 2 to a row mix
+    int bestResponseCol(const double* row_mix) const {
+        int best = 0;
+        double best_payoff = -INFINITY;
+        for (int j = 0; j < game.cols(); j++) {
+            double payoff = 0.0;
+            for (int i = 0; i < game.rows(); i++) {
+                payoff += row_mix[i] * game.getPayoffUnchecked(i, j, 1);
+            }
+            if (payoff > best_payoff) {
+                best_payoff = payoff;
+                best = j;
+            }
+        }
+        return best;
+    }
+    
+    // Check that neither player gains more than tolerance by a pure deviation
+    bool isNashEquilibrium(const double* row_mix, const double* col_mix, double tolerance = 1e-6) const {
+        double p1_payoff = expectedPayoff(0, row_mix, col_mix);
+        double p2_payoff = expectedPayoff(1, row_mix, col_mix);
+        for (int i = 0; i < game.rows(); i++) {
+            double payoff = 0.0;
+            for (int j = 0; j < game.cols(); j++) {
+                payoff += col_mix[j] * game.getPayoffUnchecked(i, j, 0);
+            }
+            if (payoff > p1_payoff + tolerance) {
+                return false;
+            }
+        }
+        for (int j = 0; j < game.cols(); j++) {
+            double payoff = 0.0;
+            for (int i = 0; i < game.rows(); i++) {
+                payoff += row_mix[i] * game.getPayoffUnchecked(i, j, 1);
+            }
+            if (payoff > p2_payoff + tolerance) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Check whether a pure profile is a Nash equilibrium
+    bool isPureNashEquilibrium(int row, int col) const {
+        for (int k = 0; k < game.rows(); k++) {
+            if (game.getPayoffUnchecked(k, col, 0) > game.getPayoffUnchecked(row, col, 0)) {
+                return false;
+            }
+        }
+        for (int k = 0; k < game.cols(); k++) {
+            if (game.getPayoffUnchecked(row, k, 1) > game.getPayoffUnchecked(row, col, 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Find all pure strategy Nash equilibria in row-major order
+    // Each cell is compared against its column maximum (player 1) and row
+    // maximum (player 2), so the cost is O(R*C) rather than O(R*C*(R+C)).
+    vector<PureProfile> findPureNashEquilibria() const {
+        vector<double> col_max(game.cols(), -INFINITY);
+        vector<double> row_max(game.rows(), -INFINITY);
+        for (int i = 0; i < game.rows(); i++) {
+            for (int j = 0; j < game.cols(); j++) {
+                col_max[j] = max(col_max[j], game.getPayoffUnchecked(i, j, 0));
+                row_max[i] = max(row_max[i], game.getPayoffUnchecked(i, j, 1));
+            }
+        }
+        
+        vector<PureProfile> equilibria;
+        for (int i = 0; i < game.rows(); i++) {
+            for (int j = 0; j < game.cols(); j++) {
+                if (game.getPayoffUnchecked(i, j, 0) >= col_max[j] && game.getPayoffUnchecked(i, j, 1) >= row_max[i]) {
+                    equilibria.emplace_back(i, j);
+                }
+            }
+        }
+        return equilibria;
+    }
+};
+
+#endif // BIMATRIX_GAME_H
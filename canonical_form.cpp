@@ -0,0 +1,46 @@
+#include "canonical_form.h"
+
+using namespace std;
+
+// Reduce a 2x2 game to its canonical form. The eight relabelings are tried in
+// the order the generic search visits them, so both find the same form.
+bool canonicalize(const Game2x2& game, CanonicalForm<Game2x2>& form, uint8_t symmetries) {
+    double normalized[8];
+    if (!normalizePayoffs(game, form, symmetries, normalized)) {
+        return false;
+    }
+    
+    // Bit 0 of a relabeling swaps the rows, bit 1 the columns, bit 2 the players
+    const int relabelings[8] = {0, 2, 1, 3, 4, 6, 5, 7};
+    bool permute = (symmetries & CANONICAL_PERMUTE_STRATEGIES) != 0;
+    bool swap_players = (symmetries & CANONICAL_SWAP_PLAYERS) != 0;
+    
+    int best = -1;
+    for (int relabeling : relabelings) {
+        if (((relabeling & 3) && !permute) || ((relabeling & 4) && !swap_players)) {
+            continue;
+        }
+        OrientedPayoffs oriented = {normalized, 2, (relabeling & 4) != 0};
+        double candidate[8];
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2; j++) {
+                for (int k = 0; k < 2; k++) {
+                    candidate[(i * 2 + j) * 2 + k] = oriented.at(i ^ (relabeling & 1), j ^ ((relabeling >> 1) & 1), k);
+                }
+            }
+        }
+        if (best < 0 || lexicographical_compare(candidate, candidate + 8, form.game.payoffs.begin(),
+                                                form.game.payoffs.end())) {
+            copy(candidate, candidate + 8, form.game.payoffs.begin());
+            best = relabeling;
+        }
+    }
+    
+    int row = best & 1;
+    int col = (best >> 1) & 1;
+    form.players_swapped = (best & 4) != 0;
+    form.row_map.assign({row, 1 - row});
+    form.col_map.assign({col, 1 - col});
+    form.hash = hashGamePayoffs(form.game);
+    return true;
+}
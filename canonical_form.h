@@ -0,0 +1,390 @@
+#ifndef CANONICAL_FORM_H
+#define CANONICAL_FORM_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include "bimatrix_game.h"
+#include "game_solver.h"
+#include "nash_engine.h"
+
+using namespace std;
+
+// Largest number of strategy orderings (rows! * cols!) searched exhaustively
+// for a canonical form; 4x4 games and smaller are canonical under every
+// permutation, larger ones are ordered by row and column signatures.
+const int kExhaustiveCanonicalOrderings = 576;
+
+// Integer payoffs up to this magnitude are normalized, which is exact for them
+const double kExactIntegerPayoff = 4503599627370496.0; // 2^52
+
+// Symmetries a canonical form may use
+enum CanonicalSymmetries : uint8_t {
+    CANONICAL_PERMUTE_STRATEGIES = 1, // Reorder each player's strategies
+    CANONICAL_SWAP_PLAYERS = 2,       // Exchange the players (square games only)
+    CANONICAL_AFFINE_PAYOFFS = 4,     // Shift and scale each player's payoffs
+    CANONICAL_ALL_SYMMETRIES = 7
+};
+
+// Resize the storage of a canonical game (a no-op for fixed-size games)
+template<int R, int C>
+inline void resizeGame(Game<R, C>&, int, int) {}
+
+inline void resizeGame(DynamicGame& game, int rows, int cols) {
+    game = DynamicGame(rows, cols);
+}
+
+// Game type a canonical form is stored in: fixed-size games keep their type,
+// anything else (e.g. a GameView) is copied into a DynamicGame
+template<class GameT>
+struct CanonicalStorage {
+    typedef DynamicGame type;
+};
+
+template<int R, int C>
+struct CanonicalStorage<Game<R, C>> {
+    typedef Game<R, C> type;
+};
+
+// Representative of a game's equivalence class under row and column
+// permutations, swapping the players (square games only) and a positive
+// affine transform of each player's integer payoffs, together with the transform
+// that maps the game onto it. Equivalent games have the same representative,
+// so it can key a cache of solved equilibria. Nash equilibria are invariant
+// under all of these. The non-myopic equilibria found by NormalFormSolver are
+// invariant under swapping the players only: where a player is indifferent
+// they depend on the order of the strategies, and on the exact rounding of
+// the payoffs.
+template<class StorageT>
+struct CanonicalForm {
+    StorageT game;        // Canonical payoffs, see canonicalize
+    uint64_t hash;        // Hash of the canonical payoffs
+    vector<int> row_map;  // Original strategy of each canonical row
+    vector<int> col_map;  // Original strategy of each canonical column
+    bool players_swapped; // Canonical player 1 is the original player 2 (rows and columns transposed)
+    double offset[2];     // Smallest payoff of each original player
+    double scale[2];      // Payoff unit of each original player: canonical = (payoff - offset) / scale
+    
+    // Original player behind a canonical player
+    int originalPlayer(int player) const {
+        return players_swapped ? 1 - player : player;
+    }
+};
+
+// Hash of a game's payoffs, by bit pattern
+template<class GameT>
+uint64_t hashGamePayoffs(const GameT& game) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)game.rows() << 32) ^ (uint64_t)game.cols();
+    for (int i = 0; i < game.rows(); i++) {
+        for (int j = 0; j < game.cols(); j++) {
+            for (int k = 0; k < 2; k++) {
+                double value = game.getPayoffUnchecked(i, j, k);
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                h = (h ^ bits) * 0xFF51AFD7ED558CCDULL;
+                h ^= h >> 32;
+            }
+        }
+    }
+    return h;
+}
+
+// Whether two games have the same dimensions and payoffs
+template<class GameT>
+bool samePayoffs(const GameT& a, const GameT& b) {
+    if (a.rows() != b.rows() || a.cols() != b.cols()) {
+        return false;
+    }
+    for (int i = 0; i < a.rows(); i++) {
+        for (int j = 0; j < a.cols(); j++) {
+            if (a.getPayoffUnchecked(i, j, 0) != b.getPayoffUnchecked(i, j, 0) ||
+                a.getPayoffUnchecked(i, j, 1) != b.getPayoffUnchecked(i, j, 1)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Normalized payoffs of a game seen in one orientation: with swap the
+// players and the roles of rows and columns are exchanged
+struct OrientedPayoffs {
+    const double* normalized; // [row][col][player] of the original game
+    int cols;                 // Columns of the original game
+    bool swap;
+    
+    double at(int row, int col, int player) const {
+        if (swap) {
+            return normalized[(col * cols + row) * 2 + (1 - player)];
+        }
+        return normalized[(row * cols + col) * 2 + player];
+    }
+};
+
+// Compare the games given by two orderings of an oriented game in
+// [row][col][player] order: negative, zero or positive like strcmp
+inline int compareOrderings(const OrientedPayoffs& a, const vector<int>& a_rows, const vector<int>& a_cols,
+                            const OrientedPayoffs& b, const vector<int>& b_rows, const vector<int>& b_cols) {
+    for (size_t i = 0; i < a_rows.size(); i++) {
+        for (size_t j = 0; j < a_cols.size(); j++) {
+            for (int k = 0; k < 2; k++) {
+                double x = a.at(a_rows[i], a_cols[j], k);
+                double y = b.at(b_rows[i], b_cols[j], k);
+                if (x != y) {
+                    return x < y ? -1 : 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Order the strategies of one side of an oriented game by signature: the
+// sorted (own payoff, other payoff) pairs of each strategy. Strategies with
+// equal signatures keep their relative order.
+inline vector<int> signatureOrder(const OrientedPayoffs& payoffs, int own_count, int other_count, bool rows) {
+    vector<vector<double>> signatures(own_count);
+    for (int s = 0; s < own_count; s++) {
+        vector<pair<double, double>> cells;
+        cells.reserve(other_count);
+        for (int t = 0; t < other_count; t++) {
+            int i = rows ? s : t;
+            int j = rows ? t : s;
+            cells.emplace_back(payoffs.at(i, j, rows ? 0 : 1), payoffs.at(i, j, rows ? 1 : 0));
+        }
+        sort(cells.begin(), cells.end());
+        for (const auto& cell : cells) {
+            signatures[s].push_back(cell.first);
+            signatures[s].push_back(cell.second);
+        }
+    }
+    vector<int> order(own_count);
+    for (int s = 0; s < own_count; s++) {
+        order[s] = s;
+    }
+    stable_sort(order.begin(), order.end(), [&signatures](int a, int b) { return signatures[a] < signatures[b]; });
+    return order;
+}
+
+// Set the payoff offset and scale of each player in form (see canonicalize)
+// and write the game's normalized payoffs, in [row][col][player] order, to
+// normalized. Returns false if a payoff, or a player's range, is not finite.
+template<class GameT, class StorageT>
+bool normalizePayoffs(const GameT& game, CanonicalForm<StorageT>& form, uint8_t symmetries, double* normalized) {
+    int rows = game.rows();
+    int cols = game.cols();
+    
+    for (int k = 0; k < 2; k++) {
+        double lo = INFINITY;
+        double hi = -INFINITY;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                double value = game.getPayoffUnchecked(i, j, k);
+                if (!isfinite(value)) {
+                    return false;
+                }
+                lo = min(lo, value);
+                hi = max(hi, value);
+            }
+        }
+        if (!isfinite(hi - lo)) {
+            return false;
+        }
+        form.offset[k] = 0.0;
+        form.scale[k] = 1.0;
+        
+        // Only integer payoffs are shifted and divided by the gcd of their
+        // differences, which is exact. Rounding a shift or scale of other
+        // payoffs could map distinct games onto one form, so they are kept.
+        bool affine = (symmetries & CANONICAL_AFFINE_PAYOFFS) != 0;
+        if (affine && lo >= -kExactIntegerPayoff && hi <= kExactIntegerPayoff) {
+            int64_t unit = 0;
+            for (int i = 0; i < rows && unit >= 0; i++) {
+                for (int j = 0; j < cols; j++) {
+                    double value = game.getPayoffUnchecked(i, j, k);
+                    if (value != floor(value)) {
+                        unit = -1;
+                        break;
+                    }
+                    if (unit != 1) {
+                        unit = gcd(unit, (int64_t)(value - lo));
+                    }
+                }
+            }
+            if (unit >= 0) {
+                form.offset[k] = lo;
+                form.scale[k] = unit > 0 ? (double)unit : 1.0;
+            }
+        }
+    }
+    
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            for (int k = 0; k < 2; k++) {
+                normalized[(i * cols + j) * 2 + k] = (game.getPayoffUnchecked(i, j, k) - form.offset[k]) / form.scale[k];
+            }
+        }
+    }
+    return true;
+}
+
+// Reduce a game to its canonical form under the given symmetries. With
+// CANONICAL_AFFINE_PAYOFFS a player whose payoffs are all integers has them
+// shifted to start at 0 and divided by the gcd of their differences, which is
+// exact; other players' payoffs are left as they are. Then every orientation
+// (both when the game is square and the players may be swapped) and every
+// ordering of the strategies (when they may be permuted) is tried, and the
+// one whose payoffs are lexicographically smallest in [row][col][player]
+// order is kept. Games with more than kExhaustiveCanonicalOrderings orderings
+// are sorted by strategy signatures instead. This finds the same form unless
+// two strategies tie on their signature; such games may miss a cache entry
+// but never hit a wrong one. Since every step is exact, two games share a form
+// only if they are equivalent. Returns false (leaving form undefined) if a
+// payoff, or a player's payoff range, is not finite.
+template<class GameT, class StorageT>
+bool canonicalize(const GameT& game, CanonicalForm<StorageT>& form,
+                  uint8_t symmetries = CANONICAL_ALL_SYMMETRIES) {
+    int rows = game.rows();
+    int cols = game.cols();
+    
+    vector<double> normalized(2 * rows * cols);
+    if (!normalizePayoffs(game, form, symmetries, normalized.data())) {
+        return false;
+    }
+    
+    double orderings = 1.0;
+    for (int n = 2; n <= rows; n++) {
+        orderings *= n;
+    }
+    for (int n = 2; n <= cols; n++) {
+        orderings *= n;
+    }
+    bool permute = (symmetries & CANONICAL_PERMUTE_STRATEGIES) != 0;
+    bool exhaustive = orderings <= kExhaustiveCanonicalOrderings;
+    int orientations = (rows == cols && (symmetries & CANONICAL_SWAP_PLAYERS)) ? 2 : 1;
+    
+    OrientedPayoffs best = {normalized.data(), cols, false};
+    vector<int> best_rows;
+    vector<int> best_cols;
+    for (int orientation = 0; orientation < orientations; orientation++) {
+        OrientedPayoffs oriented = {normalized.data(), cols, orientation == 1};
+        vector<int> row_order(rows);
+        vector<int> col_order(cols);
+        if (!permute || exhaustive) {
+            for (int i = 0; i < rows; i++) {
+                row_order[i] = i;
+            }
+            do {
+                for (int j = 0; j < cols; j++) {
+                    col_order[j] = j;
+                }
+                do {
+                    if (best_rows.empty() ||
+                        compareOrderings(oriented, row_order, col_order, best, best_rows, best_cols) < 0) {
+                        best = oriented;
+                        best_rows = row_order;
+                        best_cols = col_order;
+                    }
+                } while (permute && next_permutation(col_order.begin(), col_order.end()));
+            } while (permute && next_permutation(row_order.begin(), row_order.end()));
+        } else {
+            row_order = signatureOrder(oriented, rows, cols, true);
+            col_order = signatureOrder(oriented, cols, rows, false);
+            if (best_rows.empty() || compareOrderings(oriented, row_order, col_order, best, best_rows, best_cols) < 0) {
+                best = oriented;
+                best_rows = row_order;
+                best_cols = col_order;
+            }
+        }
+    }
+    
+    form.players_swapped = best.swap;
+    form.row_map = best_rows;
+    form.col_map = best_cols;
+    resizeGame(form.game, rows, cols);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            for (int k = 0; k < 2; k++) {
+                form.game.setPayoff(i, j, k, best.at(best_rows[i], best_cols[j], k));
+            }
+        }
+    }
+    form.hash = hashGamePayoffs(form.game);
+    return true;
+}
+
+// Same form for a 2x2 game, found without heap allocation once the maps of
+// form have been sized by an earlier call
+bool canonicalize(const Game2x2& game, CanonicalForm<Game2x2>& form, uint8_t symmetries = CANONICAL_ALL_SYMMETRIES);
+
+// Map a pure profile of the canonical game back to the original game
+template<class StorageT>
+PureProfile fromCanonical(const CanonicalForm<StorageT>& form, const PureProfile& profile) {
+    int row = form.row_map[profile.row];
+    int col = form.col_map[profile.col];
+    return form.players_swapped ? PureProfile(col, row) : PureProfile(row, col);
+}
+
+// Map an equilibrium of the canonical game back to the original game: the
+// strategies are permuted back, and the payoffs scaled back to the original player's
+template<class StorageT>
+MixedEquilibrium fromCanonical(const CanonicalForm<StorageT>& form, const MixedEquilibrium& eq) {
+    MixedEquilibrium result;
+    vector<double> first(eq.row_strategy.size());
+    vector<double> second(eq.col_strategy.size());
+    for (size_t i = 0; i < first.size(); i++) {
+        first[form.row_map[i]] = eq.row_strategy[i];
+    }
+    for (size_t j = 0; j < second.size(); j++) {
+        second[form.col_map[j]] = eq.col_strategy[j];
+    }
+    double first_payoff = eq.row_payoff * form.scale[form.originalPlayer(0)] + form.offset[form.originalPlayer(0)];
+    double second_payoff = eq.col_payoff * form.scale[form.originalPlayer(1)] + form.offset[form.originalPlayer(1)];
+    if (form.players_swapped) {
+        result.row_strategy = second;
+        result.col_strategy = first;
+        result.row_payoff = second_payoff;
+        result.col_payoff = first_payoff;
+    } else {
+        result.row_strategy = first;
+        result.col_strategy = second;
+        result.row_payoff = first_payoff;
+        result.col_payoff = second_payoff;
+    }
+    return result;
+}
+
+// Map a 2x2 equilibrium record of the canonical game back to the original
+// game. Reordering a player's strategies turns a probability x into 1 - x
+// (pure profiles, which store strategy indices, map the same way), and
+// swapping the players exchanges the two coordinates.
+inline Equilibrium fromCanonical(const CanonicalForm<Game2x2>& form, const Equilibrium& eq) {
+    double p_lo = eq.profile.p1_strategy1_prob;
+    double p_hi = eq.profile_end.p1_strategy1_prob;
+    double q_lo = eq.profile.p2_strategy1_prob;
+    double q_hi = eq.profile_end.p2_strategy1_prob;
+    if (form.row_map[0] != 0) {
+        double lo = 1.0 - p_hi;
+        p_hi = 1.0 - p_lo;
+        p_lo = lo;
+    }
+    if (form.col_map[0] != 0) {
+        double lo = 1.0 - q_hi;
+        q_hi = 1.0 - q_lo;
+        q_lo = lo;
+    }
+    if (form.players_swapped) {
+        swap(p_lo, q_lo);
+        swap(p_hi, q_hi);
+    }
+    
+    Equilibrium result = eq;
+    result.profile = StrategyProfile(p_lo, q_lo);
+    result.profile_end = StrategyProfile(p_hi, q_hi);
+    return result;
+}
+
+#endif // CANONICAL_FORM_H
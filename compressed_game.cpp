@@ -0,0 +1,146 @@
+#include "compressed_game.h"
+#include <algorithm>
+
+using namespace std;
+
+double SparsePayoffMatrix::at(int row, int col) const {
+    auto begin = col_index.begin() + row_start[row];
+    auto end = col_index.begin() + row_start[row + 1];
+    auto it = lower_bound(begin, end, col);
+    if (it != end && *it == col) {
+        return values[it - col_index.begin()];
+    }
+    return base;
+}
+
+void SparsePayoffMatrix::multiply(const double* x, double* y) const {
+    // Every row gets base times the total weight of x, plus its entries' deviations from base
+    double total = 0.0;
+    for (int j = 0; j < num_cols; j++) {
+        total += x[j];
+    }
+    for (int i = 0; i < num_rows; i++) {
+        double sum = base * total;
+        for (size_t k = row_start[i]; k < row_start[i + 1]; k++) {
+            sum += (values[k] - base) * x[col_index[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+void SparsePayoffMatrix::multiplyTransposed(const double* x, double* y) const {
+    double total = 0.0;
+    for (int i = 0; i < num_rows; i++) {
+        total += x[i];
+    }
+    for (int j = 0; j < num_cols; j++) {
+        y[j] = base * total;
+    }
+    for (int i = 0; i < num_rows; i++) {
+        double weight = x[i];
+        if (weight == 0.0) {
+            continue;
+        }
+        for (size_t k = row_start[i]; k < row_start[i + 1]; k++) {
+            y[col_index[k]] += weight * (values[k] - base);
+        }
+    }
+}
+
+void LowRankPayoffMatrix::multiply(const double* x, double* y) const {
+    // t = V^T x, then y = U t: two passes over the factors, never the matrix
+    vector<double> t(rank, 0.0);
+    for (int j = 0; j < num_cols; j++) {
+        const double* vj = v.data() + (size_t)j * rank;
+        for (int r = 0; r < rank; r++) {
+            t[r] += x[j] * vj[r];
+        }
+    }
+    for (int i = 0; i < num_rows; i++) {
+        const double* ui = u.data() + (size_t)i * rank;
+        double sum = 0.0;
+        for (int r = 0; r < rank; r++) {
+            sum += ui[r] * t[r];
+        }
+        y[i] = sum;
+    }
+}
+
+void LowRankPayoffMatrix::multiplyTransposed(const double* x, double* y) const {
+    vector<double> t(rank, 0.0);
+    for (int i = 0; i < num_rows; i++) {
+        const double* ui = u.data() + (size_t)i * rank;
+        for (int r = 0; r < rank; r++) {
+            t[r] += x[i] * ui[r];
+        }
+    }
+    for (int j = 0; j < num_cols; j++) {
+        const double* vj = v.data() + (size_t)j * rank;
+        double sum = 0.0;
+        for (int r = 0; r < rank; r++) {
+            sum += vj[r] * t[r];
+        }
+        y[j] = sum;
+    }
+}
+
+bool buildSparseGame(int rows, int cols, double base1, double base2, const vector<SparseEntry>& entries,
+                     SparseGame& game) {
+    if (rows < 0 || cols < 0) {
+        return false;
+    }
+    for (const SparseEntry& entry : entries) {
+        if (entry.row < 0 || entry.row >= rows || entry.col < 0 || entry.col >= cols ||
+            entry.player < 0 || entry.player > 1) {
+            return false;
+        }
+    }
+    
+    const double bases[2] = {base1, base2};
+    for (int player = 0; player < 2; player++) {
+        // Entries of this player in row-major order; stable, so the last of
+        // several entries for one cell comes last
+        vector<const SparseEntry*> sorted;
+        for (const SparseEntry& entry : entries) {
+            if (entry.player == player) {
+                sorted.push_back(&entry);
+            }
+        }
+        stable_sort(sorted.begin(), sorted.end(), [](const SparseEntry* a, const SparseEntry* b) {
+            return a->row != b->row ? a->row < b->row : a->col < b->col;
+        });
+        
+        SparsePayoffMatrix matrix(rows, cols, bases[player]);
+        for (size_t k = 0; k < sorted.size(); k++) {
+            const SparseEntry& entry = *sorted[k];
+            bool last = k + 1 == sorted.size() || sorted[k + 1]->row != entry.row || sorted[k + 1]->col != entry.col;
+            if (!last || entry.payoff == matrix.base) {
+                continue;
+            }
+            matrix.col_index.push_back(entry.col);
+            matrix.values.push_back(entry.payoff);
+            matrix.row_start[entry.row + 1]++;
+        }
+        for (int i = 0; i < rows; i++) {
+            matrix.row_start[i + 1] += matrix.row_start[i];
+        }
+        game.matrices[player] = matrix;
+    }
+    return true;
+}
+
+bool buildLowRankGame(int rows, int cols, int rank1, const vector<double>& u1, const vector<double>& v1,
+                      int rank2, const vector<double>& u2, const vector<double>& v2, LowRankGame& game) {
+    if (rows < 0 || cols < 0 || rank1 < 0 || rank2 < 0 ||
+        u1.size() != (size_t)rows * rank1 || v1.size() != (size_t)cols * rank1 ||
+        u2.size() != (size_t)rows * rank2 || v2.size() != (size_t)cols * rank2) {
+        return false;
+    }
+    game.matrices[0] = LowRankPayoffMatrix(rows, cols, rank1);
+    game.matrices[0].u = u1;
+    game.matrices[0].v = v1;
+    game.matrices[1] = LowRankPayoffMatrix(rows, cols, rank2);
+    game.matrices[1].u = u2;
+    game.matrices[1].v = v2;
+    return true;
+}
@@ -0,0 +1,255 @@
+#ifndef COMPRESSED_GAME_H
+#define COMPRESSED_GAME_H
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+// Compressed storage for bimatrix games too large to hold densely, such as
+// discretized auctions with 10^4 strategies per player. Each game type has the
+// read interface of DynamicGame (rows(), cols(), getPayoff(),
+// getPayoffUnchecked()), so the templated solvers run on it unchanged, and
+// also exposes its payoff matrices for CompressedGameSolver, whose kernels
+// never expand a matrix.
+
+// One player's payoff matrix: a constant, and the cells that differ from it in
+// compressed sparse row form. Memory is O(rows + nonzeros).
+struct SparsePayoffMatrix {
+    int num_rows;
+    int num_cols;
+    double base;               // Payoff of every cell not stored
+    vector<size_t> row_start;  // Entries of row i are [row_start[i], row_start[i + 1])
+    vector<int> col_index;     // Column of each entry, ascending within a row
+    vector<double> values;     // Payoff of each entry
+    
+    SparsePayoffMatrix(int rows = 0, int cols = 0, double b = 0.0)
+        : num_rows(rows), num_cols(cols), base(b), row_start(rows + 1, 0) {}
+    
+    size_t nonZeros() const { return values.size(); }
+    
+    // Payoff of a cell, by binary search within its row
+    double at(int row, int col) const;
+    
+    // y = A x: the payoff of each row against a column mix x
+    void multiply(const double* x, double* y) const;
+    
+    // y = A^T x: the payoff of each column against a row mix x
+    void multiplyTransposed(const double* x, double* y) const;
+};
+
+// One player's payoff matrix in factored form A = U V^T, U rows x rank and
+// V cols x rank, both row-major. Memory is O((rows + cols) * rank).
+struct LowRankPayoffMatrix {
+    int num_rows;
+    int num_cols;
+    int rank;
+    vector<double> u;
+    vector<double> v;
+    
+    LowRankPayoffMatrix(int rows = 0, int cols = 0, int k = 0)
+        : num_rows(rows), num_cols(cols), rank(k), u((size_t)rows * k, 0.0), v((size_t)cols * k, 0.0) {}
+    
+    // Payoff of a cell, a dot product of two factor rows
+    double at(int row, int col) const {
+        const double* ur = u.data() + (size_t)row * rank;
+        const double* vc = v.data() + (size_t)col * rank;
+        double sum = 0.0;
+        for (int r = 0; r < rank; r++) {
+            sum += ur[r] * vc[r];
+        }
+        return sum;
+    }
+    
+    // y = U (V^T x)
+    void multiply(const double* x, double* y) const;
+    
+    // y = V (U^T x)
+    void multiplyTransposed(const double* x, double* y) const;
+};
+
+// Entry of a sparse game: one player's payoff in one cell
+struct SparseEntry {
+    int row;
+    int col;
+    int player;
+    double payoff;
+};
+
+// Bimatrix game whose payoff matrices are SparsePayoffMatrix
+struct SparseGame {
+    SparsePayoffMatrix matrices[2];
+    
+    int rows() const { return matrices[0].num_rows; }
+    int cols() const { return matrices[0].num_cols; }
+    const SparsePayoffMatrix& payoffMatrix(int player) const { return matrices[player]; }
+    
+    // Get payoff for a specific outcome
+    double getPayoff(int row, int col, int player) const {
+        if (row >= 0 && row < rows() && col >= 0 && col < cols() && player >= 0 && player < 2) {
+            return matrices[player].at(row, col);
+        }
+        return 0.0;
+    }
+    
+    // Get payoff without bounds checking; a binary search, not a load
+    double getPayoffUnchecked(int row, int col, int player) const {
+        return matrices[player].at(row, col);
+    }
+};
+
+// Bimatrix game whose payoff matrices are LowRankPayoffMatrix
+struct LowRankGame {
+    LowRankPayoffMatrix matrices[2];
+    
+    int rows() const { return matrices[0].num_rows; }
+    int cols() const { return matrices[0].num_cols; }
+    const LowRankPayoffMatrix& payoffMatrix(int player) const { return matrices[player]; }
+    
+    // Get payoff for a specific outcome
+    double getPayoff(int row, int col, int player) const {
+        if (row >= 0 && row < rows() && col >= 0 && col < cols() && player >= 0 && player < 2) {
+            return matrices[player].at(row, col);
+        }
+        return 0.0;
+    }
+    
+    // Get payoff without bounds checking; a dot product of length rank
+    double getPayoffUnchecked(int row, int col, int player) const {
+        return matrices[player].at(row, col);
+    }
+};
+
+// Build a sparse game from the payoffs that differ from each player's base.
+// A cell given twice keeps its last payoff; entries equal to the base are
+// dropped. Returns false if an entry is out of range.
+bool buildSparseGame(int rows, int cols, double base1, double base2, const vector<SparseEntry>& entries,
+                     SparseGame& game);
+
+// Build a low-rank game from the factors of both players' matrices, each
+// row-major as in LowRankPayoffMatrix. Returns false if a factor has the wrong size.
+bool buildLowRankGame(int rows, int cols, int rank1, const vector<double>& u1, const vector<double>& v1,
+                      int rank2, const vector<double>& u2, const vector<double>& v2, LowRankGame& game);
+
+// Compress a dense game: each player's most common payoff becomes the base
+// and only the other cells are stored
+template<class GameT>
+SparseGame sparsify(const GameT& game) {
+    double base[2];
+    for (int player = 0; player < 2; player++) {
+        map<double, size_t> counts;
+        base[player] = 0.0;
+        size_t best = 0;
+        for (int i = 0; i < game.rows(); i++) {
+            for (int j = 0; j < game.cols(); j++) {
+                size_t count = ++counts[game.getPayoffUnchecked(i, j, player)];
+                if (count > best) {
+                    best = count;
+                    base[player] = game.getPayoffUnchecked(i, j, player);
+                }
+            }
+        }
+    }
+    
+    vector<SparseEntry> entries;
+    for (int i = 0; i < game.rows(); i++) {
+        for (int j = 0; j < game.cols(); j++) {
+            for (int player = 0; player < 2; player++) {
+                if (game.getPayoffUnchecked(i, j, player) != base[player]) {
+                    entries.push_back({i, j, player, game.getPayoffUnchecked(i, j, player)});
+                }
+            }
+        }
+    }
+    SparseGame sparse;
+    buildSparseGame(game.rows(), game.cols(), base[0], base[1], entries, sparse);
+    return sparse;
+}
+
+// Expected payoffs and best responses on a game exposing payoffMatrix(player)
+// with multiply() and multiplyTransposed() (SparseGame, LowRankGame). Same
+// interface as BimatrixSolver, but every kernel is a matrix-vector product in
+// the compressed form: O(rows + nonzeros) for a sparse game and
+// O((rows + cols) * rank) for a low-rank one, instead of O(rows * cols).
+template<class GameT>
+class CompressedGameSolver {
+private:
+    const GameT& game;
+    
+    static double dot(const double* a, const double* b, int n) {
+        double sum = 0.0;
+        for (int k = 0; k < n; k++) {
+            sum += a[k] * b[k];
+        }
+        return sum;
+    }
+    
+    // Lowest index of the largest value
+    static int argmax(const vector<double>& values) {
+        int best = 0;
+        for (int k = 1; k < (int)values.size(); k++) {
+            if (values[k] > values[best]) {
+                best = k;
+            }
+        }
+        return best;
+    }
+
+public:
+    CompressedGameSolver(const GameT& g) : game(g) {}
+    
+    // Expected payoff of each row for player 1 against a column mix
+    void rowPayoffs(const double* col_mix, double* out) const {
+        game.payoffMatrix(0).multiply(col_mix, out);
+    }
+    
+    // Expected payoff of each column for player 2 against a row mix
+    void colPayoffs(const double* row_mix, double* out) const {
+        game.payoffMatrix(1).multiplyTransposed(row_mix, out);
+    }
+    
+    // Expected payoff for a player under a mixed strategy profile
+    double expectedPayoff(int player, const double* row_mix, const double* col_mix) const {
+        vector<double> payoffs(game.rows());
+        game.payoffMatrix(player).multiply(col_mix, payoffs.data());
+        return dot(row_mix, payoffs.data(), game.rows());
+    }
+    
+    // Lowest-index pure best response of player 1 to a column mix
+    int bestResponseRow(const double* col_mix) const {
+        vector<double> payoffs(game.rows());
+        rowPayoffs(col_mix, payoffs.data());
+        return argmax(payoffs);
+    }
+    
+    // Lowest-index pure best response of player 2 to a row mix
+    int bestResponseCol(const double* row_mix) const {
+        vector<double> payoffs(game.cols());
+        colPayoffs(row_mix, payoffs.data());
+        return argmax(payoffs);
+    }
+    
+    // Check that neither player gains more than tolerance by a pure deviation
+    bool isNashEquilibrium(const double* row_mix, const double* col_mix, double tolerance = 1e-6) const {
+        vector<double> row_payoffs(game.rows());
+        vector<double> col_payoffs(game.cols());
+        rowPayoffs(col_mix, row_payoffs.data());
+        colPayoffs(row_mix, col_payoffs.data());
+        double p1_payoff = dot(row_mix, row_payoffs.data(), game.rows());
+        double p2_payoff = dot(col_mix, col_payoffs.data(), game.cols());
+        for (double payoff : row_payoffs) {
+            if (payoff > p1_payoff + tolerance) {
+                return false;
+            }
+        }
+        for (double payoff : col_payoffs) {
+            if (payoff > p2_payoff + tolerance) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // COMPRESSED_GAME_H
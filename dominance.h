@@ -0,0 +1,215 @@
+#ifndef DOMINANCE_H
+#define DOMINANCE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "bimatrix_game.h"
+
+using namespace std;
+
+// Which dominated pure strategies a solver removes before solving
+enum class DominanceMode : uint8_t {
+    None,   // Keep every strategy
+    Strict, // Remove strategies strictly dominated by another pure strategy; every Nash equilibrium survives
+    Weak    // Remove weakly dominated strategies too; at least one Nash equilibrium survives, others may not
+};
+
+// Set of strategy indices, one bit per strategy
+class StrategyMask {
+private:
+    vector<uint64_t> words;
+    int num_strategies;
+
+public:
+    explicit StrategyMask(int n = 0, bool all = false)
+        : words((n + 63) / 64, all ? ~0ULL : 0ULL), num_strategies(n) {
+        // Keep the bits past the last strategy clear
+        if (all && n % 64 != 0) {
+            words.back() = (1ULL << (n % 64)) - 1;
+        }
+    }
+    
+    int size() const { return num_strategies; }
+    size_t numWords() const { return words.size(); }
+    uint64_t word(size_t w) const { return words[w]; }
+    uint64_t& word(size_t w) { return words[w]; }
+    
+    bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+    void set(int i) { words[i >> 6] |= 1ULL << (i & 63); }
+    void reset(int i) { words[i >> 6] &= ~(1ULL << (i & 63)); }
+    
+    int count() const {
+        int n = 0;
+        for (uint64_t w : words) {
+            n += __builtin_popcountll(w);
+        }
+        return n;
+    }
+    
+    bool none() const {
+        for (uint64_t w : words) {
+            if (w) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Indices of the set bits, ascending
+    vector<int> indices() const {
+        vector<int> result;
+        result.reserve(count());
+        for (size_t w = 0; w < words.size(); w++) {
+            for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+                result.push_back((int)(w * 64) + __builtin_ctzll(bits));
+            }
+        }
+        return result;
+    }
+    
+    // Remove every strategy in other
+    StrategyMask& subtract(const StrategyMask& other) {
+        for (size_t w = 0; w < words.size(); w++) {
+            words[w] &= ~other.words[w];
+        }
+        return *this;
+    }
+};
+
+// Strategies that survive iterated elimination of dominated strategies
+struct DominanceReduction {
+    StrategyMask live_rows;
+    StrategyMask live_cols;
+    vector<int> row_map; // Original index of each surviving row, ascending
+    vector<int> col_map; // Original index of each surviving column, ascending
+    int rounds;          // Passes that removed at least one strategy
+    
+    // Whether any strategy was removed
+    bool reduced() const {
+        return (int)row_map.size() < live_rows.size() || (int)col_map.size() < live_cols.size();
+    }
+};
+
+// One pass over a player's strategies: mark in `dominated` every live strategy
+// that another live strategy dominates on the opponent's live strategies.
+// payoff(own, other) is the player's payoff. For each candidate dominator k
+// the dominated set is built a word at a time: the AND over the opponent's
+// strategies of "k does at least as well" (and, for weak dominance, the OR of
+// "k does strictly better"), so a dominator that fails early costs little.
+// Both kinds of dominance are transitive, so a strategy already marked is
+// neither tried as a dominator nor tested again; trying the strategies with
+// the largest payoff sums first lets the strongest dominators mark most of
+// the set before the others are tried.
+template<class PayoffFn>
+void markDominated(const StrategyMask& own, const vector<int>& own_live, const vector<int>& other_live,
+                   bool weak, PayoffFn payoff, StrategyMask& dominated) {
+    size_t num_words = own.numWords();
+    vector<double> sums(own.size(), 0.0);
+    for (int k : own_live) {
+        for (int j : other_live) {
+            sums[k] += payoff(k, j);
+        }
+    }
+    vector<int> order = own_live;
+    stable_sort(order.begin(), order.end(), [&sums](int a, int b) { return sums[a] > sums[b]; });
+    
+    vector<uint64_t> at_least(num_words);
+    vector<uint64_t> better(num_words);
+    for (int k : order) {
+        if (dominated.test(k)) {
+            continue;
+        }
+        uint64_t any = 0;
+        for (size_t w = 0; w < num_words; w++) {
+            at_least[w] = own.word(w) & ~dominated.word(w);
+            better[w] = 0;
+            any |= at_least[w];
+        }
+        at_least[k >> 6] &= ~(1ULL << (k & 63));
+        
+        for (int j : other_live) {
+            if (!any) {
+                break;
+            }
+            double dominator = payoff(k, j);
+            any = 0;
+            for (size_t w = 0; w < num_words; w++) {
+                uint64_t ge = 0;
+                uint64_t gt = 0;
+                for (uint64_t bits = at_least[w]; bits; bits &= bits - 1) {
+                    int i = (int)(w * 64) + __builtin_ctzll(bits);
+                    double value = payoff(i, j);
+                    uint64_t bit = bits & (~bits + 1);
+                    if (weak ? dominator >= value : dominator > value) {
+                        ge |= bit;
+                    }
+                    if (dominator > value) {
+                        gt |= bit;
+                    }
+                }
+                at_least[w] = ge;
+                better[w] |= gt;
+                any |= ge;
+            }
+        }
+        
+        for (size_t w = 0; w < num_words; w++) {
+            dominated.word(w) |= weak ? (at_least[w] & better[w]) : at_least[w];
+        }
+    }
+}
+
+// Iterated elimination of pure strategies dominated by another pure strategy.
+// Rows and columns are eliminated in alternating passes until neither changes.
+// For strict dominance the surviving game does not depend on the order.
+template<class GameT>
+DominanceReduction eliminateDominatedStrategies(const GameT& game, DominanceMode mode) {
+    int rows = game.rows();
+    int cols = game.cols();
+    DominanceReduction result = {StrategyMask(rows, true), StrategyMask(cols, true), {}, {}, 0};
+    
+    if (mode != DominanceMode::None) {
+        bool weak = (mode == DominanceMode::Weak);
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int player = 0; player < 2; player++) {
+                vector<int> live_rows = result.live_rows.indices();
+                vector<int> live_cols = result.live_cols.indices();
+                StrategyMask dominated(player == 0 ? rows : cols);
+                if (player == 0) {
+                    markDominated(result.live_rows, live_rows, live_cols, weak,
+                                  [&game](int i, int j) { return game.getPayoffUnchecked(i, j, 0); }, dominated);
+                } else {
+                    markDominated(result.live_cols, live_cols, live_rows, weak,
+                                  [&game](int j, int i) { return game.getPayoffUnchecked(i, j, 1); }, dominated);
+                }
+                if (!dominated.none()) {
+                    (player == 0 ? result.live_rows : result.live_cols).subtract(dominated);
+                    result.rounds++;
+                    changed = true;
+                }
+            }
+        }
+    }
+    
+    result.row_map = result.live_rows.indices();
+    result.col_map = result.live_cols.indices();
+    return result;
+}
+
+// The game restricted to the surviving strategies, in their original order
+template<class GameT>
+DynamicGame reducedGame(const GameT& game, const DominanceReduction& reduction) {
+    DynamicGame reduced((int)reduction.row_map.size(), (int)reduction.col_map.size());
+    for (int i = 0; i < reduced.rows(); i++) {
+        for (int j = 0; j < reduced.cols(); j++) {
+            reduced.setPayoff(i, j, 0, game.getPayoffUnchecked(reduction.row_map[i], reduction.col_map[j], 0));
+            reduced.setPayoff(i, j, 1, game.getPayoffUnchecked(reduction.row_map[i], reduction.col_map[j], 1));
+        }
+    }
+    return reduced;
+}
+
+#endif // DOMINANCE_H
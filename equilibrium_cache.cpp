@@ -0,0 +1,82 @@
+#include "equilibrium_cache.h"
+#include <algorithm>
+
+using namespace std;
+
+// Best response box a coordinate range of a Nash equilibrium came from, in the
+// order findMixedNashEquilibriaAnalytic visits them: strategy 1, strategy 2, indifferent
+static int responseBox(double lo, double hi) {
+    if (lo == hi && lo == 1.0) {
+        return 0;
+    }
+    return (lo == hi && lo == 0.0) ? 1 : 2;
+}
+
+// Order of NormalFormSolver::findAllNashEquilibria: pure equilibria in
+// row-major order, then the other boxes in the order they are generated
+static bool nashBefore(const Equilibrium& a, const Equilibrium& b) {
+    if (a.isPure != b.isPure) {
+        return a.isPure;
+    }
+    const double ka[6] = {
+        a.isPure ? 0.0 : (double)responseBox(a.profile.p1_strategy1_prob, a.profile_end.p1_strategy1_prob),
+        a.isPure ? 0.0 : (double)responseBox(a.profile.p2_strategy1_prob, a.profile_end.p2_strategy1_prob),
+        a.profile.p1_strategy1_prob, a.profile.p2_strategy1_prob,
+        a.profile_end.p1_strategy1_prob, a.profile_end.p2_strategy1_prob};
+    const double kb[6] = {
+        b.isPure ? 0.0 : (double)responseBox(b.profile.p1_strategy1_prob, b.profile_end.p1_strategy1_prob),
+        b.isPure ? 0.0 : (double)responseBox(b.profile.p2_strategy1_prob, b.profile_end.p2_strategy1_prob),
+        b.profile.p1_strategy1_prob, b.profile.p2_strategy1_prob,
+        b.profile_end.p1_strategy1_prob, b.profile_end.p2_strategy1_prob};
+    return lexicographical_compare(ka, ka + 6, kb, kb + 6);
+}
+
+// Solve a 2x2 game through a cache keyed by canonical form
+GameSolution2x2 solveCached(const Game2x2& game, EquilibriumCache2x2& cache) {
+    // Reused by every call on this thread, so canonicalize does not allocate
+    static thread_local CanonicalForm<Game2x2> nash_form;
+    static thread_local CanonicalForm<Game2x2> nme_form;
+    GameSolution2x2 solution;
+    if (!canonicalize(game, nash_form) || !canonicalize(game, nme_form, CANONICAL_SWAP_PLAYERS)) {
+        NormalFormSolver solver(game);
+        solution.nash_equilibria = solver.findAllNashEquilibria();
+        solution.non_myopic_equilibria = solver.findNonMyopicEquilibria();
+        return solution;
+    }
+    
+    auto mapNash = [&solution](const vector<Equilibrium>& canonical) {
+        solution.nash_equilibria.reserve(canonical.size());
+        for (const auto& eq : canonical) {
+            solution.nash_equilibria.push_back(fromCanonical(nash_form, eq));
+        }
+        stable_sort(solution.nash_equilibria.begin(), solution.nash_equilibria.end(), nashBefore);
+    };
+    if (!cache.nash.visit(nash_form, mapNash)) {
+        vector<Equilibrium> canonical = NormalFormSolver(nash_form.game).findAllNashEquilibria();
+        cache.nash.insert(nash_form, canonical);
+        mapNash(canonical);
+    }
+    
+    // The non-myopic equilibria are every pair of a player 1 range and a player 2
+    // range, player 1's varying slowest; with the players swapped that is transposed
+    auto mapNonMyopic = [&solution](const vector<Equilibrium>& canonical) {
+        size_t inner = 0;
+        while (inner < canonical.size() &&
+               canonical[inner].profile.p1_strategy1_prob == canonical[0].profile.p1_strategy1_prob &&
+               canonical[inner].profile_end.p1_strategy1_prob == canonical[0].profile_end.p1_strategy1_prob) {
+            inner++;
+        }
+        size_t outer = inner ? canonical.size() / inner : 0;
+        solution.non_myopic_equilibria.reserve(canonical.size());
+        for (size_t i = 0; i < canonical.size(); i++) {
+            size_t source = nme_form.players_swapped ? (i % outer) * inner + i / outer : i;
+            solution.non_myopic_equilibria.push_back(fromCanonical(nme_form, canonical[source]));
+        }
+    };
+    if (!cache.non_myopic.visit(nme_form, mapNonMyopic)) {
+        vector<Equilibrium> canonical = NormalFormSolver(nme_form.game).findNonMyopicEquilibria();
+        cache.non_myopic.insert(nme_form, canonical);
+        mapNonMyopic(canonical);
+    }
+    return solution;
+}
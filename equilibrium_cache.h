@@ -0,0 +1,186 @@
+#ifndef EQUILIBRIUM_CACHE_H
+#define EQUILIBRIUM_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "canonical_form.h"
+#include "game_solver.h"
+#include "nash_engine.h"
+
+using namespace std;
+
+// Thread-safe map from canonical games to their solutions. Entries are spread
+// over independently locked shards by hash, so solver threads working through
+// a batch rarely wait on each other. Each shard holds at most capacity / shards
+// entries and is emptied when it fills up, which bounds memory on corpora with
+// few repeats while keeping the common games of a batch cached.
+template<class StorageT, class Value>
+class EquilibriumCache {
+private:
+    struct Key {
+        StorageT game;
+        uint64_t hash;
+        
+        bool operator==(const Key& other) const {
+            return hash == other.hash && samePayoffs(game, other.game);
+        }
+    };
+    
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return (size_t)key.hash;
+        }
+    };
+    
+    // One shard, padded to its own cache line
+    struct alignas(64) Shard {
+        mutex lock;
+        unordered_map<Key, Value, KeyHash> entries;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+    
+    unique_ptr<Shard[]> shards;
+    int num_shards;
+    size_t shard_capacity;
+    
+    // The shard of a canonical form, chosen by the high bits of its hash
+    Shard& shardFor(uint64_t hash) const {
+        return shards[(hash >> 32) % (uint64_t)num_shards];
+    }
+
+public:
+    // A cache of up to capacity entries in num_shards shards
+    explicit EquilibriumCache(size_t capacity = 1 << 16, int num_shards = 64)
+        : shards(new Shard[num_shards > 0 ? num_shards : 1]), num_shards(num_shards > 0 ? num_shards : 1),
+          shard_capacity(max<size_t>(1, capacity / (num_shards > 0 ? num_shards : 1))) {}
+    
+    EquilibriumCache(const EquilibriumCache&) = delete;
+    EquilibriumCache& operator=(const EquilibriumCache&) = delete;
+    
+    // Call visitor(value) on the solution of a canonical game while its shard is
+    // locked, which saves copying it; returns false on a miss
+    template<class Visitor>
+    bool visit(const CanonicalForm<StorageT>& form, Visitor visitor) {
+        Shard& shard = shardFor(form.hash);
+        lock_guard<mutex> guard(shard.lock);
+        auto it = shard.entries.find(Key{form.game, form.hash});
+        if (it == shard.entries.end()) {
+            shard.misses++;
+            return false;
+        }
+        shard.hits++;
+        visitor(it->second);
+        return true;
+    }
+    
+    // Copy the solution of a canonical game into value; returns false on a miss
+    bool find(const CanonicalForm<StorageT>& form, Value& value) {
+        return visit(form, [&value](const Value& found) { value = found; });
+    }
+    
+    // Store the solution of a canonical game
+    void insert(const CanonicalForm<StorageT>& form, const Value& value) {
+        Shard& shard = shardFor(form.hash);
+        lock_guard<mutex> guard(shard.lock);
+        if (shard.entries.size() >= shard_capacity) {
+            shard.entries.clear();
+        }
+        shard.entries.emplace(Key{form.game, form.hash}, value);
+    }
+    
+    // Entries, hits and misses over all shards
+    size_t size() const {
+        size_t total = 0;
+        for (int s = 0; s < num_shards; s++) {
+            lock_guard<mutex> guard(shards[s].lock);
+            total += shards[s].entries.size();
+        }
+        return total;
+    }
+    
+    uint64_t hits() const {
+        uint64_t total = 0;
+        for (int s = 0; s < num_shards; s++) {
+            lock_guard<mutex> guard(shards[s].lock);
+            total += shards[s].hits;
+        }
+        return total;
+    }
+    
+    uint64_t misses() const {
+        uint64_t total = 0;
+        for (int s = 0; s < num_shards; s++) {
+            lock_guard<mutex> guard(shards[s].lock);
+            total += shards[s].misses;
+        }
+        return total;
+    }
+    
+    void clear() {
+        for (int s = 0; s < num_shards; s++) {
+            lock_guard<mutex> guard(shards[s].lock);
+            shards[s].entries.clear();
+            shards[s].hits = 0;
+            shards[s].misses = 0;
+        }
+    }
+};
+
+// Nash and non-myopic equilibria of a 2x2 game
+struct GameSolution2x2 {
+    vector<Equilibrium> nash_equilibria;
+    vector<Equilibrium> non_myopic_equilibria;
+};
+
+// Caches for solveCached. Nash equilibria are keyed by the canonical form
+// under all symmetries, non-myopic equilibria by the form under player swaps.
+struct EquilibriumCache2x2 {
+    EquilibriumCache<Game2x2, vector<Equilibrium>> nash;
+    EquilibriumCache<Game2x2, vector<Equilibrium>> non_myopic;
+    
+    explicit EquilibriumCache2x2(size_t capacity = 1 << 16, int num_shards = 64)
+        : nash(capacity, num_shards), non_myopic(capacity, num_shards) {}
+};
+
+// Solve a 2x2 game with the analytic NormalFormSolver through a cache: each
+// canonical game is looked up, solved on a miss, and its equilibria are mapped
+// back and listed in the order a direct solve lists them. Every game goes
+// through its canonical forms, hit or miss, so the results do not depend on
+// what the cache holds; they match a direct solve up to the rounding of a
+// probability x mapped back as 1 - x. Games with non-finite payoffs are solved
+// directly.
+GameSolution2x2 solveCached(const Game2x2& game, EquilibriumCache2x2& cache);
+
+// Exact equilibria of a game by support enumeration, through a cache keyed by
+// canonical form. The equilibria are mapped back from the canonical game and
+// listed in the order support enumeration finds them there.
+template<class GameT>
+vector<MixedEquilibrium> supportEnumerationCached(
+    const GameT& game, EquilibriumCache<typename CanonicalStorage<GameT>::type, vector<MixedEquilibrium>>& cache) {
+    CanonicalForm<typename CanonicalStorage<GameT>::type> form;
+    if (!canonicalize(game, form)) {
+        return NashEngine<GameT>(game).supportEnumeration();
+    }
+    
+    vector<MixedEquilibrium> equilibria;
+    auto mapBack = [&form, &equilibria](const vector<MixedEquilibrium>& canonical) {
+        equilibria.reserve(canonical.size());
+        for (const auto& eq : canonical) {
+            equilibria.push_back(fromCanonical(form, eq));
+        }
+    };
+    if (!cache.visit(form, mapBack)) {
+        vector<MixedEquilibrium> canonical =
+            NashEngine<typename CanonicalStorage<GameT>::type>(form.game).supportEnumeration();
+        cache.insert(form, canonical);
+        mapBack(canonical);
+    }
+    return equilibria;
+}
+
+#endif // EQUILIBRIUM_CACHE_H
@@ -0,0 +1,228 @@
+#ifndef GAME_3X3_H
+#define GAME_3X3_H
+
+#include <array>
+#include <vector>
+#include "game_solver.h"
+#include "dominance.h"
+#include "nash_engine.h"
+#include "solver_stats.h"
+
+using namespace std;
+
+// Structure to represent a 3x3 normal form game
+typedef Game<3, 3> Game3x3;
+
+// Structure to represent a 2x2 submatrix with its source positions
+struct Submatrix2x2 {
+    Game2x2 game;
+    array<pair<int, int>, 4> positions; // Original positions in 3x3 matrix: [(row1,col1), (row2,col2), (row3,col3), (row4,col4)]
+};
+
+// Equilibria of one 2x2 subgame
+struct SubmatrixAnalysis {
+    Submatrix2x2 submatrix;
+    vector<Equilibrium> nash_equilibria;
+    vector<Equilibrium> non_myopic_equilibria;
+    int submatrix_id;
+};
+
+// A subgame NME mapped back to a pure outcome of the 3x3 game
+struct SubgameVote {
+    int submatrix_id;
+    int row;
+    int col;
+};
+
+// Outcome of the 3x3 game predicted by the subgame NME votes
+struct SubgamePrediction {
+    vector<SubgameVote> votes;  // One per subgame NME, in submatrix order
+    array<int, 9> outcome_votes; // Votes per outcome, indexed row * 3 + col
+    array<int, 3> row_votes;     // Votes per row of player 1
+    array<int, 3> col_votes;     // Votes per column of player 2
+    int max_votes;               // Votes of the best supported outcome(s), 0 if none
+    int num_subgames;
+};
+
+// Build the 2x2 submatrix of a 3x3 game on rows r1 < r2 and columns c1 < c2
+inline Submatrix2x2 makeSubmatrix3x3(const Game3x3& game, int r1, int r2, int c1, int c2) {
+    Submatrix2x2 submatrix;
+    submatrix.positions[0] = make_pair(r1, c1); // Top-left
+    submatrix.positions[1] = make_pair(r1, c2); // Top-right
+    submatrix.positions[2] = make_pair(r2, c1); // Bottom-left
+    submatrix.positions[3] = make_pair(r2, c2); // Bottom-right
+    submatrix.game = extractSubgame2x2(game, r1, r2, c1, c2);
+    return submatrix;
+}
+
+// Pure outcome of the 3x3 game that a subgame NME votes for
+inline SubgameVote subgameVote(const SubmatrixAnalysis& analysis, const Equilibrium& nme) {
+    // Convert probabilities to pure strategies (with tolerance)
+    int p1_strategy = (nme.profile.p1_strategy1_prob > 0.5) ? 0 : 1;
+    int p2_strategy = (nme.profile.p2_strategy1_prob > 0.5) ? 0 : 1;
+    
+    // Map back to 3x3 coordinates: positions[0] is the top-left
+    // cell and positions[3] the bottom-right cell of the submatrix
+    int row = analysis.submatrix.positions[p1_strategy * 3].first;
+    int col = analysis.submatrix.positions[p2_strategy * 3].second;
+    return {analysis.submatrix_id, row, col};
+}
+
+class Game3x3Solver {
+private:
+    Game3x3 game3x3;
+    
+    // Strategies left after the dominance pre-pass; subgames using any other are skipped
+    DominanceMode dominance;
+    DominanceReduction reduction;
+    
+    // Subgame results keyed by (row pair, column pair), each solved at most once
+    array<SubmatrixAnalysis, 9> subgame_cache;
+    array<bool, 9> subgame_solved;
+    
+    // Index of the strategy pair a < b: (0,1) -> 0, (0,2) -> 1, (1,2) -> 2
+    static int pairIndex(int a, int b) {
+        return a + b - 1;
+    }
+    
+    // Build the 2x2 submatrix on rows r1 < r2 and columns c1 < c2
+    Submatrix2x2 makeSubmatrix(int r1, int r2, int c1, int c2) const {
+        GAMESOLVER_PHASE(SubgameExtraction);
+        return makeSubmatrix3x3(game3x3, r1, r2, c1, c2);
+    }
+    
+    // Solve the subgame on rows r1 < r2 and columns c1 < c2, reusing an earlier result
+    const SubmatrixAnalysis& solveSubgame(int r1, int r2, int c1, int c2) {
+        int key = pairIndex(r1, r2) * 3 + pairIndex(c1, c2);
+        SubmatrixAnalysis& analysis = subgame_cache[key];
+        if (!subgame_solved[key]) {
+            GAMESOLVER_COUNT(SubgamesSolved, 1);
+            analysis.submatrix = makeSubmatrix(r1, r2, c1, c2);
+            NormalFormSolver solver(analysis.submatrix.game);
+            analysis.nash_equilibria = solver.findAllNashEquilibria();
+            analysis.non_myopic_equilibria = solver.findNonMyopicEquilibria();
+            subgame_solved[key] = true;
+        }
+        return analysis;
+    }
+    
+    // Whether every strategy of the rectangle survived the dominance pre-pass
+    bool isLiveSubgame(int r1, int r2, int c1, int c2) const {
+        return reduction.live_rows.test(r1) && reduction.live_rows.test(r2) &&
+               reduction.live_cols.test(c1) && reduction.live_cols.test(c2);
+    }
+
+public:
+    // With a dominance mode other than None, dominated strategies are removed
+    // first: subgames that use them are not solved and the full-game equilibria
+    // are those of the reduced game, mapped back to the original strategies.
+    Game3x3Solver(const Game3x3& game, DominanceMode mode = DominanceMode::None)
+        : game3x3(game), dominance(mode), reduction(eliminateDominatedStrategies(game, mode)) {
+        subgame_solved.fill(false);
+    }
+    
+    // Strategies that survived the dominance pre-pass (all of them for DominanceMode::None)
+    const DominanceReduction& getDominanceReduction() const {
+        return reduction;
+    }
+    
+    const Game3x3& getGame() const {
+        return game3x3;
+    }
+    
+    // Extract all possible 2x2 submatrices from the 3x3 game (of the reduced game after a dominance pre-pass)
+    // Rectangles are visited in the lexicographic order of their cell indices
+    // (row-major), which is the order submatrices have always been numbered in.
+    vector<Submatrix2x2> extractAll2x2Submatrices() const {
+        vector<Submatrix2x2> submatrices;
+        submatrices.reserve(countSubgames2x2(3, 3));
+        
+        for (int r1 = 0; r1 < 3; r1++) {
+            for (int c1 = 0; c1 < 3; c1++) {
+                for (int c2 = c1 + 1; c2 < 3; c2++) {
+                    for (int r2 = r1 + 1; r2 < 3; r2++) {
+                        if (isLiveSubgame(r1, r2, c1, c2)) {
+                            submatrices.push_back(makeSubmatrix(r1, r2, c1, c2));
+                        }
+                    }
+                }
+            }
+        }
+        
+        return submatrices;
+    }
+    
+    // Analyze all 2x2 submatrices using the existing 2x2 solver.
+    // Each subgame is solved once per solver and reused on later calls.
+    // Subgames keep their number in the full game when others are skipped.
+    vector<SubmatrixAnalysis> analyzeAll2x2Submatrices() {
+        vector<SubmatrixAnalysis> analyses;
+        analyses.reserve(countSubgames2x2(3, 3));
+        
+        int count = 1;
+        for (int r1 = 0; r1 < 3; r1++) {
+            for (int c1 = 0; c1 < 3; c1++) {
+                for (int c2 = c1 + 1; c2 < 3; c2++) {
+                    for (int r2 = r1 + 1; r2 < 3; r2++, count++) {
+                        if (isLiveSubgame(r1, r2, c1, c2)) {
+                            analyses.push_back(solveSubgame(r1, r2, c1, c2));
+                            analyses.back().submatrix_id = count;
+                        }
+                    }
+                }
+            }
+        }
+        
+        return analyses;
+    }
+    
+    // Calculate 3x3 NME based on subgame analysis
+    // Strategy: look for consistency across subgames by counting how often
+    // each pure outcome appears in the NME of the subgames.
+    SubgamePrediction calculate3x3NMEFromSubgames() {
+        vector<SubmatrixAnalysis> analyses = analyzeAll2x2Submatrices();
+        
+        GAMESOLVER_PHASE(Voting);
+        SubgamePrediction prediction;
+        prediction.outcome_votes.fill(0);
+        prediction.row_votes.fill(0);
+        prediction.col_votes.fill(0);
+        prediction.max_votes = 0;
+        prediction.num_subgames = (int)analyses.size();
+        
+        for (const auto& analysis : analyses) {
+            for (const auto& nme : analysis.non_myopic_equilibria) {
+                SubgameVote vote = subgameVote(analysis, nme);
+                prediction.votes.push_back(vote);
+                int votes = ++prediction.outcome_votes[vote.row * 3 + vote.col];
+                prediction.row_votes[vote.row]++;
+                prediction.col_votes[vote.col]++;
+                prediction.max_votes = max(prediction.max_votes, votes);
+            }
+        }
+        
+        return prediction;
+    }
+    
+    // Find the pure strategy Nash equilibria of the full 3x3 game
+    vector<PureProfile> findPureNashEquilibria() const {
+        if (!reduction.reduced()) {
+            return BimatrixSolver<Game3x3>(game3x3).findPureNashEquilibria();
+        }
+        DynamicGame reduced = reducedGame(game3x3, reduction);
+        vector<PureProfile> equilibria = BimatrixSolver<DynamicGame>(reduced).findPureNashEquilibria();
+        for (auto& eq : equilibria) {
+            eq = PureProfile(reduction.row_map[eq.row], reduction.col_map[eq.col]);
+        }
+        return equilibria;
+    }
+    
+    // Find the exact Nash equilibria of the full 3x3 game by support enumeration
+    // (which always skips strictly dominated strategies)
+    vector<MixedEquilibrium> findExactNashEquilibria() const {
+        DominanceMode mode = (dominance == DominanceMode::Weak) ? DominanceMode::Weak : DominanceMode::Strict;
+        return NashEngine<Game3x3>(game3x3, mode).supportEnumeration();
+    }
+};
+
+#endif // GAME_3X3_H
@@ -0,0 +1,324 @@
+#include "game_io.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Header for a new file, with the count filled in later
+static GameFileHeader makeHeader(const char* magic, int rows, int cols, uint16_t layout, uint64_t count) {
+    GameFileHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, magic, sizeof(hdr.magic));
+    hdr.version = GAME_FILE_VERSION;
+    hdr.layout = layout;
+    hdr.rows = (uint32_t)rows;
+    hdr.cols = (uint32_t)cols;
+    hdr.count = count;
+    return hdr;
+}
+
+MappedGameFile::MappedGameFile() : fd(-1), base(nullptr), length(0) {
+    memset(&hdr, 0, sizeof(hdr));
+}
+
+MappedGameFile::~MappedGameFile() {
+    close();
+}
+
+// Map a game file and validate its header
+bool MappedGameFile::open(const string& path) {
+    close();
+    
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(GameFileHeader)) {
+        error = path + " is too small to be a game file";
+        close();
+        return false;
+    }
+    length = (size_t)st.st_size;
+    
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        error = "cannot map " + path;
+        close();
+        return false;
+    }
+    base = mapping;
+    // Solvers stream through the payoffs once, front to back
+    madvise(base, length, MADV_SEQUENTIAL);
+    memcpy(&hdr, base, sizeof(hdr));
+    
+    if (memcmp(hdr.magic, GAME_FILE_MAGIC, sizeof(hdr.magic)) != 0) {
+        error = path + " is not a game file";
+    } else if (hdr.version != GAME_FILE_VERSION) {
+        error = path + " has unsupported version " + to_string(hdr.version);
+    } else if (hdr.rows == 0 || hdr.cols == 0 || hdr.rows > 65536 || hdr.cols > 65536) {
+        error = path + " has invalid dimensions";
+    } else if (hdr.layout != GAME_LAYOUT_INTERLEAVED &&
+               !(hdr.layout == GAME_LAYOUT_PLANAR && hdr.rows == 2 && hdr.cols == 2)) {
+        error = path + " has an unsupported layout";
+    } else {
+        uint64_t game_bytes = 2 * sizeof(double) * (uint64_t)hdr.rows * hdr.cols;
+        if (hdr.count > (length - sizeof(GameFileHeader)) / game_bytes) {
+            error = path + " is truncated";
+        } else {
+            error.clear();
+            return true;
+        }
+    }
+    close();
+    return false;
+}
+
+void MappedGameFile::close() {
+    if (base) {
+        munmap(base, length);
+        base = nullptr;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    length = 0;
+    memset(&hdr, 0, sizeof(hdr));
+}
+
+// Structure-of-arrays view of a planar 2x2 file
+bool MappedGameFile::batch2x2(BatchGames2x2& games) const {
+    if (!base || hdr.layout != GAME_LAYOUT_PLANAR) {
+        return false;
+    }
+    const double* data = payoffs();
+    size_t n = count();
+    games = {data, data + n, data + 2 * n, data + 3 * n,
+             data + 4 * n, data + 5 * n, data + 6 * n, data + 7 * n, n};
+    return true;
+}
+
+// Start a file of rows x cols games
+bool GameFileWriter::open(const string& path, int rows, int cols, size_t buffer_games) {
+    close();
+    if (rows <= 0 || cols <= 0) {
+        error = "invalid game dimensions";
+        return false;
+    }
+    num_rows = rows;
+    num_cols = cols;
+    buffered = 0;
+    written = 0;
+    buffer.assign(max<size_t>(1, buffer_games) * 2 * rows * cols, 0.0);
+    
+    out.open(path, ios::binary | ios::trunc);
+    GameFileHeader hdr = makeHeader(GAME_FILE_MAGIC, rows, cols, GAME_LAYOUT_INTERLEAVED, 0);
+    out.write((const char*)&hdr, sizeof(hdr));
+    if (!out) {
+        error = "cannot write " + path;
+        out.close();
+        return false;
+    }
+    error.clear();
+    return true;
+}
+
+bool GameFileWriter::flush() {
+    size_t game_size = 2 * num_rows * num_cols;
+    out.write((const char*)buffer.data(), buffered * game_size * sizeof(double));
+    buffered = 0;
+    if (!out) {
+        error = "write failed";
+        return false;
+    }
+    return true;
+}
+
+// Slot for the next game in the buffer
+double* GameFileWriter::nextSlot() {
+    if (!out.is_open()) {
+        error = "file is not open";
+        return nullptr;
+    }
+    size_t game_size = 2 * num_rows * num_cols;
+    if ((buffered + 1) * game_size > buffer.size() && !flush()) {
+        return nullptr;
+    }
+    double* slot = buffer.data() + buffered * game_size;
+    buffered++;
+    written++;
+    return slot;
+}
+
+// Append one game in [row][col][player] order
+bool GameFileWriter::write(const double* payoffs) {
+    double* slot = nextSlot();
+    if (!slot) {
+        return false;
+    }
+    memcpy(slot, payoffs, 2 * num_rows * num_cols * sizeof(double));
+    return true;
+}
+
+// Flush, write the final count and close
+bool GameFileWriter::close() {
+    if (!out.is_open()) {
+        return error.empty();
+    }
+    bool ok = flush();
+    GameFileHeader hdr = makeHeader(GAME_FILE_MAGIC, num_rows, num_cols, GAME_LAYOUT_INTERLEAVED, written);
+    out.seekp(0);
+    out.write((const char*)&hdr, sizeof(hdr));
+    ok = ok && (bool)out;
+    out.close();
+    if (!ok && error.empty()) {
+        error = "write failed";
+    }
+    return ok;
+}
+
+// Write a planar 2x2 game file from structure-of-arrays streams
+bool writePlanarGameFile(const string& path, const BatchGames2x2& games, string* error) {
+    ofstream out(path, ios::binary | ios::trunc);
+    GameFileHeader hdr = makeHeader(GAME_FILE_MAGIC, 2, 2, GAME_LAYOUT_PLANAR, games.count);
+    out.write((const char*)&hdr, sizeof(hdr));
+    const double* streams[8] = {games.a00, games.a01, games.a10, games.a11,
+                                games.b00, games.b01, games.b10, games.b11};
+    for (const double* stream : streams) {
+        out.write((const char*)stream, games.count * sizeof(double));
+    }
+    if (!out) {
+        if (error) {
+            *error = "cannot write " + path;
+        }
+        return false;
+    }
+    return true;
+}
+
+// Start a result file
+bool ResultFileWriter::open(const string& path, size_t buffer_records) {
+    close();
+    buffered = 0;
+    written = 0;
+    buffer.resize(max<size_t>(1, buffer_records));
+    
+    out.open(path, ios::binary | ios::trunc);
+    GameFileHeader hdr = makeHeader(RESULT_FILE_MAGIC, 2, 2, GAME_LAYOUT_INTERLEAVED, 0);
+    out.write((const char*)&hdr, sizeof(hdr));
+    if (!out) {
+        error = "cannot write " + path;
+        out.close();
+        return false;
+    }
+    error.clear();
+    return true;
+}
+
+bool ResultFileWriter::flush() {
+    out.write((const char*)buffer.data(), buffered * sizeof(ResultRecord2x2));
+    buffered = 0;
+    if (!out) {
+        error = "write failed";
+        return false;
+    }
+    return true;
+}
+
+// Append the first `count` results of a batch
+bool ResultFileWriter::write(const BatchResults2x2& results, size_t count) {
+    if (!out.is_open()) {
+        error = "file is not open";
+        return false;
+    }
+    for (size_t g = 0; g < count; g++) {
+        if (buffered == buffer.size() && !flush()) {
+            return false;
+        }
+        ResultRecord2x2& record = buffer[buffered++];
+        record.pure_mask = results.pure_mask[g];
+        record.num_equilibria = results.num_equilibria[g];
+        record.flags = results.flags[g];
+        memset(record.reserved, 0, sizeof(record.reserved));
+        record.mixed_p1 = results.mixed_p1[g];
+        record.mixed_p2 = results.mixed_p2[g];
+    }
+    written += count;
+    return true;
+}
+
+// Flush, write the final count and close
+bool ResultFileWriter::close() {
+    if (!out.is_open()) {
+        return error.empty();
+    }
+    bool ok = flush();
+    GameFileHeader hdr = makeHeader(RESULT_FILE_MAGIC, 2, 2, GAME_LAYOUT_INTERLEAVED, written);
+    out.seekp(0);
+    out.write((const char*)&hdr, sizeof(hdr));
+    ok = ok && (bool)out;
+    out.close();
+    if (!ok && error.empty()) {
+        error = "write failed";
+    }
+    return ok;
+}
+
+// Solve every game of a 2x2 game file and stream the results to out_path
+bool solveGameFile2x2(const string& in_path, const string& out_path, size_t* degenerate, string* error) {
+    MappedGameFile file;
+    ResultFileWriter writer;
+    string message;
+    if (!file.open(in_path)) {
+        message = file.lastError();
+    } else if (file.rows() != 2 || file.cols() != 2) {
+        message = in_path + " does not hold 2x2 games";
+    } else if (!writer.open(out_path)) {
+        message = writer.lastError();
+    }
+    if (!message.empty()) {
+        if (error) {
+            *error = message;
+        }
+        return false;
+    }
+    
+    // Fixed-size result buffers, reused for every block
+    const size_t block = 65536;
+    vector<uint8_t> pure_mask(block), num_equilibria(block), flags(block);
+    vector<double> mixed_p1(block), mixed_p2(block);
+    BatchResults2x2 results = {pure_mask.data(), num_equilibria.data(), flags.data(),
+                               mixed_p1.data(), mixed_p2.data()};
+    
+    BatchGames2x2 planar;
+    bool is_planar = file.batch2x2(planar);
+    BatchKernel kernel = detectBatchKernel();
+    size_t total_degenerate = 0;
+    bool ok = true;
+    for (size_t begin = 0; begin < file.count() && ok; begin += block) {
+        size_t n = min(block, file.count() - begin);
+        if (is_planar) {
+            BatchGames2x2 slice = {planar.a00 + begin, planar.a01 + begin, planar.a10 + begin, planar.a11 + begin,
+                                   planar.b00 + begin, planar.b01 + begin, planar.b10 + begin, planar.b11 + begin, n};
+            total_degenerate += solveBatch2x2(slice, results, kernel);
+        } else {
+            total_degenerate += solveBatch2x2Interleaved(file.payoffs() + begin * 8, n, results, kernel);
+        }
+        ok = writer.write(results, n);
+    }
+    ok = writer.close() && ok;
+    
+    if (!ok && error) {
+        *error = writer.lastError();
+    }
+    if (degenerate) {
+        *degenerate = total_degenerate;
+    }
+    return ok;
+}
@@ -0,0 +1,194 @@
+#ifndef GAME_IO_H
+#define GAME_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "bimatrix_game.h"
+#include "batch_solver.h"
+
+using namespace std;
+
+// Binary game corpus format, in native (little-endian) byte order:
+//   GameFileHeader, 64 bytes
+//   payoffs of `count` rows x cols games, as doubles
+// Interleaved layout: one game after another, each in Game<R,C> order [row][col][player].
+// Planar layout (2x2 only): the eight streams a00 a01 a10 a11 b00 b01 b10 b11 of
+// BatchGames2x2 one after another, each holding `count` doubles.
+// Result files reuse the header with a different magic and hold `count` ResultRecord2x2.
+
+const char GAME_FILE_MAGIC[8] = {'N', 'F', 'G', 'A', 'M', 'E', 'S', '\0'};
+const char RESULT_FILE_MAGIC[8] = {'N', 'F', 'R', 'E', 'S', 'L', 'T', '\0'};
+const uint16_t GAME_FILE_VERSION = 1;
+
+enum GameFileLayout : uint16_t {
+    GAME_LAYOUT_INTERLEAVED = 0,
+    GAME_LAYOUT_PLANAR = 1
+};
+
+// Fixed-size file header, padded to a cache line so payoffs start aligned
+struct GameFileHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t layout; // GameFileLayout
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t reserved;
+    uint64_t count; // Number of games (or results)
+    uint8_t padding[32];
+};
+static_assert(sizeof(GameFileHeader) == 64, "GameFileHeader must be 64 bytes");
+
+// Solution of one 2x2 game as stored in a result file (see BatchResults2x2)
+struct ResultRecord2x2 {
+    uint8_t pure_mask;
+    uint8_t num_equilibria;
+    uint8_t flags;
+    uint8_t reserved[5];
+    double mixed_p1;
+    double mixed_p2;
+};
+static_assert(sizeof(ResultRecord2x2) == 24, "ResultRecord2x2 must be 24 bytes");
+
+// Read-only memory mapping of a game file. Payoffs are used in place: game()
+// and batch2x2() return views into the mapping, nothing is copied to the heap.
+class MappedGameFile {
+private:
+    int fd;
+    void* base;
+    size_t length;
+    GameFileHeader hdr;
+    string error;
+
+public:
+    MappedGameFile();
+    ~MappedGameFile();
+    
+    MappedGameFile(const MappedGameFile&) = delete;
+    MappedGameFile& operator=(const MappedGameFile&) = delete;
+    
+    // Map a game file and validate its header. Returns false (see lastError) on failure.
+    bool open(const string& path);
+    void close();
+    
+    bool isOpen() const { return base != nullptr; }
+    const GameFileHeader& header() const { return hdr; }
+    size_t count() const { return (size_t)hdr.count; }
+    int rows() const { return (int)hdr.rows; }
+    int cols() const { return (int)hdr.cols; }
+    
+    // Start of the payoff data
+    const double* payoffs() const {
+        return (const double*)((const char*)base + sizeof(GameFileHeader));
+    }
+    
+    // View of game i of an interleaved file
+    GameView game(size_t i) const {
+        return GameView(rows(), cols(), payoffs() + i * 2 * hdr.rows * hdr.cols);
+    }
+    
+    // Structure-of-arrays view of a planar 2x2 file. Returns false for any other file.
+    bool batch2x2(BatchGames2x2& games) const;
+    
+    const string& lastError() const { return error; }
+};
+
+// Streaming writer for interleaved game files. Games are buffered and written
+// in large blocks; the game count is patched into the header by close().
+class GameFileWriter {
+private:
+    ofstream out;
+    vector<double> buffer;
+    size_t buffered;
+    uint64_t written;
+    int num_rows;
+    int num_cols;
+    string error;
+    
+    bool flush();
+    
+    // Slot for the next game in the buffer, flushing first if it is full; null on a write error
+    double* nextSlot();
+
+public:
+    GameFileWriter() : buffered(0), written(0), num_rows(0), num_cols(0) {}
+    ~GameFileWriter() { close(); }
+    
+    // Start a file of rows x cols games. Returns false (see lastError) on failure.
+    bool open(const string& path, int rows, int cols, size_t buffer_games = 65536);
+    
+    // Append one game given as rows * cols * 2 payoffs in [row][col][player] order
+    bool write(const double* payoffs);
+    
+    // Append any game with the dimensions given to open(). Only types with
+    // getPayoffUnchecked take part, so pointers go to the overload above.
+    // Returns false, writing nothing, if the game's dimensions differ.
+    template<class GameT, class = decltype(declval<const GameT&>().getPayoffUnchecked(0, 0, 0))>
+    bool write(const GameT& game) {
+        if (out.is_open() && (game.rows() != num_rows || game.cols() != num_cols)) {
+            error = "game is " + to_string(game.rows()) + "x" + to_string(game.cols()) + ", file holds " +
+                    to_string(num_rows) + "x" + to_string(num_cols) + " games";
+            return false;
+        }
+        double* slot = nextSlot();
+        if (!slot) {
+            return false;
+        }
+        for (int i = 0; i < num_rows; i++) {
+            for (int j = 0; j < num_cols; j++) {
+                *slot++ = game.getPayoffUnchecked(i, j, 0);
+                *slot++ = game.getPayoffUnchecked(i, j, 1);
+            }
+        }
+        return true;
+    }
+    
+    // Flush, write the final count and close. Returns false if any write failed.
+    bool close();
+    
+    uint64_t gamesWritten() const { return written; }
+    const string& lastError() const { return error; }
+};
+
+// Write a planar 2x2 game file from structure-of-arrays streams
+bool writePlanarGameFile(const string& path, const BatchGames2x2& games, string* error = nullptr);
+
+// Streaming writer for 2x2 result files
+class ResultFileWriter {
+private:
+    ofstream out;
+    vector<ResultRecord2x2> buffer;
+    size_t buffered;
+    uint64_t written;
+    string error;
+    
+    bool flush();
+
+public:
+    ResultFileWriter() : buffered(0), written(0) {}
+    ~ResultFileWriter() { close(); }
+    
+    // Start a result file. Returns false (see lastError) on failure.
+    bool open(const string& path, size_t buffer_records = 65536);
+    
+    // Append the first `count` results of a batch
+    bool write(const BatchResults2x2& results, size_t count);
+    
+    // Flush, write the final count and close. Returns false if any write failed.
+    bool close();
+    
+    uint64_t resultsWritten() const { return written; }
+    const string& lastError() const { return error; }
+};
+
+// Solve every game of a 2x2 game file (either layout) and stream the results
+// to out_path. Games are read in place from the mapping and solved block by
+// block into fixed-size buffers, so memory use does not grow with the corpus.
+// Returns false on an I/O or format error.
+bool solveGameFile2x2(const string& in_path, const string& out_path, size_t* degenerate = nullptr,
+                      string* error = nullptr);
+
+#endif // GAME_IO_H
@@ -0,0 +1,261 @@
+#include "game_report.h"
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+// Probability, or "[lo, hi]" for a range
+static string describeProbability(double lo, double hi) {
+    if (lo == hi) {
+        return to_string(lo);
+    }
+    return "[" + to_string(lo) + ", " + to_string(hi) + "]";
+}
+
+// Text of one equilibrium
+string describeEquilibrium(const Equilibrium& eq) {
+    const StrategyProfile& lo = eq.profile;
+    const StrategyProfile& hi = eq.profile_end;
+    switch (eq.kind) {
+    case EquilibriumKind::PureNash:
+        return "Pure strategy NE: Player 1 plays " + to_string((int)lo.p1_strategy1_prob) +
+               ", Player 2 plays " + to_string((int)lo.p2_strategy1_prob);
+    case EquilibriumKind::MixedNash:
+        return "Mixed strategy NE: Player 1 plays strategy 1 with probability " +
+               to_string(lo.p1_strategy1_prob) + ", Player 2 plays strategy 1 with probability " +
+               to_string(lo.p2_strategy1_prob);
+    case EquilibriumKind::NashContinuum:
+        return "Continuum of NE: Player 1 plays strategy 1 with probability " +
+               describeProbability(lo.p1_strategy1_prob, hi.p1_strategy1_prob) +
+               ", Player 2 plays strategy 1 with probability " +
+               describeProbability(lo.p2_strategy1_prob, hi.p2_strategy1_prob);
+    case EquilibriumKind::NonMyopic:
+        return "Non-myopic equilibrium: Player 1 plays strategy 1 with probability " +
+               describeProbability(lo.p1_strategy1_prob, hi.p1_strategy1_prob) +
+               ", Player 2 plays strategy 1 with probability " +
+               describeProbability(lo.p2_strategy1_prob, hi.p2_strategy1_prob);
+    }
+    return "";
+}
+
+// Batch output of 2x2 equilibria
+void appendBatchEquilibria(OutputBuffer& out, const vector<Equilibrium>& equilibria) {
+    if (equilibria.empty()) {
+        out.append("none");
+    }
+    for (size_t i = 0; i < equilibria.size(); i++) {
+        const Equilibrium& eq = equilibria[i];
+        if (i > 0) {
+            out.put(';');
+        }
+        if (eq.kind == EquilibriumKind::PureNash) {
+            // Pure records hold the strategy index, 0 for strategy 1
+            out.appendProbability(1.0 - eq.profile.p1_strategy1_prob);
+            out.put('/');
+            out.appendProbability(1.0 - eq.profile.p2_strategy1_prob);
+            continue;
+        }
+        out.appendProbabilityRange(eq.profile.p1_strategy1_prob, eq.profile_end.p1_strategy1_prob);
+        out.put('/');
+        out.appendProbabilityRange(eq.profile.p2_strategy1_prob, eq.profile_end.p2_strategy1_prob);
+    }
+}
+
+// Batch mode of game_2x2_solver
+void solveBatchLine2x2(const double* payoffs, OutputBuffer& out, char delimiter) {
+    Game2x2 game;
+    copy(payoffs, payoffs + game.payoffs.size(), game.payoffs.begin());
+    NormalFormSolver solver(game);
+    appendBatchEquilibria(out, solver.findAllNashEquilibria());
+    out.put(delimiter);
+    appendBatchEquilibria(out, solver.findNonMyopicEquilibria());
+}
+
+// Print a titled list of equilibria, or none_message if there are none
+void GameReporter::printEquilibria(const char* title, const vector<Equilibrium>& equilibria,
+                                   const char* none_message) const {
+    if (isQuiet()) {
+        return;
+    }
+    out << title << '\n';
+    if (equilibria.empty()) {
+        out << none_message << '\n';
+    }
+    for (const auto& eq : equilibria) {
+        out << "- " << describeEquilibrium(eq) << '\n';
+    }
+}
+
+// Print the 2x2 game matrix
+void GameReporter::printGame(const Game2x2& game) const {
+    if (isQuiet()) {
+        return;
+    }
+    out << "Game Matrix:" << '\n';
+    out << "            Player 2" << '\n';
+    out << "            Strategy 1    Strategy 2" << '\n';
+    out << "Player 1 Strategy 1: (" << fixed << setprecision(1) << game.getPayoff(0, 0, 0) << ", " << game.getPayoff(0, 0, 1)
+        << ")    (" << game.getPayoff(0, 1, 0) << ", " << game.getPayoff(0, 1, 1) << ")" << '\n';
+    out << "Player 1 Strategy 2: (" << game.getPayoff(1, 0, 0) << ", " << game.getPayoff(1, 0, 1)
+        << ")    (" << game.getPayoff(1, 1, 0) << ", " << game.getPayoff(1, 1, 1) << ")" << '\n';
+    out << '\n';
+}
+
+// Print a titled section banner
+void GameReporter::printSection(const char* title) const {
+    if (isQuiet()) {
+        return;
+    }
+    out << "\n" << string(60, '=') << '\n';
+    out << title << '\n';
+    out << string(60, '=') << '\n' << '\n';
+}
+
+// Print a 2x2 submatrix with its positions in the 3x3 game
+void GameReporter::printSubmatrix(const Submatrix2x2& submatrix) const {
+    if (isQuiet()) {
+        return;
+    }
+    const auto& positions = submatrix.positions;
+    const Game2x2& game = submatrix.game;
+    out << "2x2 Submatrix from positions: ";
+    out << "(" << positions[0].first << "," << positions[0].second << "), ";
+    out << "(" << positions[1].first << "," << positions[1].second << "), ";
+    out << "(" << positions[2].first << "," << positions[2].second << "), ";
+    out << "(" << positions[3].first << "," << positions[3].second << ")" << '\n';
+    
+    out << "            Player 2" << '\n';
+    out << "            Strategy 1    Strategy 2" << '\n';
+    out << "Player 1 Strategy 1: (" << fixed << setprecision(1)
+        << game.getPayoff(0, 0, 0) << ", " << game.getPayoff(0, 0, 1)
+        << ")    (" << game.getPayoff(0, 1, 0) << ", " << game.getPayoff(0, 1, 1) << ")" << '\n';
+    out << "Player 1 Strategy 2: (" << game.getPayoff(1, 0, 0) << ", " << game.getPayoff(1, 0, 1)
+        << ")    (" << game.getPayoff(1, 1, 0) << ", " << game.getPayoff(1, 1, 1) << ")" << '\n';
+    out << '\n';
+}
+
+// Print the equilibria of every 2x2 subgame
+void GameReporter::printSubgameAnalyses(const vector<SubmatrixAnalysis>& analyses) const {
+    if (level != ReportLevel::Detailed) {
+        return;
+    }
+    out << "Found " << analyses.size() << " valid 2x2 submatrices from the 3x3 game." << '\n' << '\n';
+    
+    for (const auto& analysis : analyses) {
+        out << "=== Submatrix " << analysis.submatrix_id << " ===" << '\n';
+        printSubmatrix(analysis.submatrix);
+        printEquilibria("Nash Equilibria for this submatrix:", analysis.nash_equilibria,
+                        "No Nash equilibria found.");
+        printEquilibria("Non-Myopic Equilibria for this submatrix:", analysis.non_myopic_equilibria,
+                        "No non-myopic equilibria found.");
+        out << string(50, '-') << '\n' << '\n';
+    }
+}
+
+// Print the votes, predicted outcomes and row/column preferences of a 3x3 prediction
+void GameReporter::printSubgamePrediction(const Game3x3& game, const SubgamePrediction& prediction) const {
+    if (isQuiet()) {
+        return;
+    }
+    out << "Analyzing subgame NME patterns..." << '\n' << '\n';
+    for (const auto& vote : prediction.votes) {
+        out << "Submatrix " << vote.submatrix_id << " votes for 3x3 outcome ("
+            << vote.row << "," << vote.col << ")" << '\n';
+    }
+    
+    out << '\n' << "Vote Summary:" << '\n';
+    for (int outcome = 0; outcome < 9; outcome++) {
+        int votes = prediction.outcome_votes[outcome];
+        if (votes == 0) {
+            continue;
+        }
+        int row = outcome / 3;
+        int col = outcome % 3;
+        out << "Outcome (" << row << "," << col << "): " << votes << " votes from submatrices: ";
+        for (const auto& vote : prediction.votes) {
+            if (vote.row == row && vote.col == col) {
+                out << vote.submatrix_id << " ";
+            }
+        }
+        out << '\n';
+    }
+    
+    // The most supported outcome(s)
+    out << '\n' << "PREDICTED 3x3 NON-MYOPIC EQUILIBRIA:" << '\n';
+    bool found_prediction = false;
+    for (int outcome = 0; outcome < 9; outcome++) {
+        int votes = prediction.outcome_votes[outcome];
+        if (votes == 0 || votes != prediction.max_votes) {
+            continue;
+        }
+        int row = outcome / 3;
+        int col = outcome % 3;
+        out << "- Pure strategy: Player 1 plays strategy " << (row + 1)
+            << ", Player 2 plays strategy " << (col + 1)
+            << " -> Outcome (" << game.getPayoff(row, col, 0) << "," << game.getPayoff(row, col, 1) << ")"
+            << " [Supported by " << votes << "/" << prediction.num_subgames << " subgames]" << '\n';
+        found_prediction = true;
+    }
+    if (!found_prediction) {
+        out << "No clear consensus from subgame analysis." << '\n';
+    }
+    
+    // Dominance patterns
+    out << '\n' << "DOMINANCE ANALYSIS:" << '\n';
+    out << "Player 1 row preferences: ";
+    for (int row = 0; row < 3; row++) {
+        if (prediction.row_votes[row] > 0) {
+            out << "Row " << (row + 1) << "(" << prediction.row_votes[row] << " votes) ";
+        }
+    }
+    out << '\n';
+    
+    out << "Player 2 column preferences: ";
+    for (int col = 0; col < 3; col++) {
+        if (prediction.col_votes[col] > 0) {
+            out << "Col " << (col + 1) << "(" << prediction.col_votes[col] << " votes) ";
+        }
+    }
+    out << '\n';
+}
+
+// Print the strategies removed by a dominance pre-pass, if any
+void GameReporter::printDominanceReduction(const DominanceReduction& reduction) const {
+    if (isQuiet() || !reduction.reduced()) {
+        return;
+    }
+    out << '\n' << "Dominated strategies removed:" << '\n';
+    for (int player = 0; player < 2; player++) {
+        const StrategyMask& live = (player == 0) ? reduction.live_rows : reduction.live_cols;
+        out << "- Player " << (player + 1) << ":";
+        int removed = 0;
+        for (int k = 0; k < live.size(); k++) {
+            if (!live.test(k)) {
+                out << (removed++ ? ", " : " strategy ") << (k + 1);
+            }
+        }
+        out << (removed ? "" : " none") << '\n';
+    }
+}
+
+// Print exact equilibria of a 3x3 game found by support enumeration
+void GameReporter::printExactNashEquilibria(const vector<MixedEquilibrium>& equilibria) const {
+    if (isQuiet()) {
+        return;
+    }
+    out << '\n' << "EXACT 3x3 NASH EQUILIBRIA (support enumeration):" << '\n';
+    if (equilibria.empty()) {
+        out << "No Nash equilibria found." << '\n';
+    }
+    for (const auto& eq : equilibria) {
+        out << "- Player 1 plays (" << fixed << setprecision(3);
+        for (size_t i = 0; i < eq.row_strategy.size(); i++) {
+            out << eq.row_strategy[i] << (i + 1 < eq.row_strategy.size() ? ", " : "");
+        }
+        out << "), Player 2 plays (";
+        for (size_t j = 0; j < eq.col_strategy.size(); j++) {
+            out << eq.col_strategy[j] << (j + 1 < eq.col_strategy.size() ? ", " : "");
+        }
+        out << ") -> Expected payoffs (" << eq.row_payoff << "," << eq.col_payoff << ")" << '\n';
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef GAME_REPORT_H
+#define GAME_REPORT_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "game_solver.h"
+#include "game_3x3.h"
+#include "text_batch.h"
+
+using namespace std;
+
+// How much a GameReporter writes
+enum class ReportLevel {
+    Quiet,   // Nothing
+    Summary, // Final results only
+    Detailed // Final results and every 2x2 subgame
+};
+
+// Text of one equilibrium, e.g. "Pure strategy NE: Player 1 plays 0, Player 2 plays 1"
+string describeEquilibrium(const Equilibrium& eq);
+
+// Batch output of 2x2 equilibria: "p/q" items separated by ';', where p and q
+// are the probabilities of strategy 1 (a pure equilibrium's strategy indices
+// are converted), a continuum is written as "lo..hi", and no equilibria as "none"
+void appendBatchEquilibria(OutputBuffer& out, const vector<Equilibrium>& equilibria);
+
+// Batch mode of game_2x2_solver: solve one game given as 8 payoffs in
+// [row][col][player] order and write its Nash and non-myopic equilibria
+void solveBatchLine2x2(const double* payoffs, OutputBuffer& out, char delimiter);
+
+// Formats solver results. The solvers return plain records and never touch
+// iostreams; all text is produced here, and only when the level asks for it.
+class GameReporter {
+private:
+    ostream& out;
+    ReportLevel level;
+
+public:
+    explicit GameReporter(ostream& os = cout, ReportLevel lvl = ReportLevel::Detailed) : out(os), level(lvl) {}
+    
+    ReportLevel getLevel() const { return level; }
+    bool isQuiet() const { return level == ReportLevel::Quiet; }
+    
+    // Print a titled list of equilibria, or none_message if there are none
+    void printEquilibria(const char* title, const vector<Equilibrium>& equilibria, const char* none_message) const;
+    
+    // Print the 2x2 game matrix
+    void printGame(const Game2x2& game) const;
+    
+    // Print a titled section banner
+    void printSection(const char* title) const;
+    
+    // Print a 2x2 submatrix with its positions in the 3x3 game
+    void printSubmatrix(const Submatrix2x2& submatrix) const;
+    
+    // Print the equilibria of every 2x2 subgame (Detailed level only)
+    void printSubgameAnalyses(const vector<SubmatrixAnalysis>& analyses) const;
+    
+    // Print the votes, predicted outcomes and row/column preferences of a 3x3 prediction
+    void printSubgamePrediction(const Game3x3& game, const SubgamePrediction& prediction) const;
+    
+    // Print the strategies removed by a dominance pre-pass, if any
+    void printDominanceReduction(const DominanceReduction& reduction) const;
+    
+    // Print exact equilibria of a 3x3 game found by support enumeration
+    void printExactNashEquilibria(const vector<MixedEquilibrium>& equilibria) const;
+};
+
+#endif // GAME_REPORT_H
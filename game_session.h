@@ -0,0 +1,206 @@
+#ifndef GAME_SESSION_H
+#define GAME_SESSION_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "game_3x3.h"
+#include "solver_stats.h"
+
+using namespace std;
+
+// Solver session for a 3x3 game edited one payoff at a time. Every piece of
+// derived data is kept together with the cells it depends on, so an edit only
+// recomputes what it invalidates:
+//   subgames          - the four cells of their rectangle; a cell lies in 4 of the 9
+//   best responses    - per subgame, only the edited player's payoffs
+//                       (NormalFormSolver::setPayoff rebuilds just that player's cache)
+//   pure NE flags     - cell (i, j) depends on column j for player 1 and row i for player 2
+//   vote tallies      - adjusted by the votes of the re-solved subgames only
+//   exact equilibria  - the whole game; recomputed on the next request after any edit
+// Edits mark subgames stale; they are re-solved by the next query. Results match
+// a fresh Game3x3Solver on the edited game.
+class GameSession3x3 {
+private:
+    Game3x3 game3x3;
+    
+    // Per subgame, in submatrix order (submatrix_id - 1)
+    vector<NormalFormSolver> solvers;
+    array<SubmatrixAnalysis, 9> analyses;
+    uint16_t stale_subgames; // Bit s set: subgame s must be re-solved
+    
+    array<bool, 9> pure_flags; // Indexed row * 3 + col
+    
+    // Vote counts of all solved subgames
+    array<int, 9> outcome_votes;
+    array<int, 3> row_votes;
+    array<int, 3> col_votes;
+    
+    vector<MixedEquilibrium> exact_equilibria;
+    bool exact_valid;
+    
+    uint64_t subgames_solved;
+    
+    // Add (sign = 1) or remove (sign = -1) the votes of subgame s
+    void tallyVotes(int s, int sign) {
+        for (const auto& nme : analyses[s].non_myopic_equilibria) {
+            SubgameVote vote = subgameVote(analyses[s], nme);
+            outcome_votes[vote.row * 3 + vote.col] += sign;
+            row_votes[vote.row] += sign;
+            col_votes[vote.col] += sign;
+        }
+    }
+    
+    void solveSubgame(int s) {
+        GAMESOLVER_COUNT(SubgamesSolved, 1);
+        analyses[s].submatrix.game = solvers[s].getGame();
+        analyses[s].nash_equilibria = solvers[s].findAllNashEquilibria();
+        analyses[s].non_myopic_equilibria = solvers[s].findNonMyopicEquilibria();
+        subgames_solved++;
+    }
+    
+    // Re-solve the stale subgames and update the vote counts
+    void refresh() {
+        for (int s = 0; s < 9 && stale_subgames; s++) {
+            if (stale_subgames & (1u << s)) {
+                tallyVotes(s, -1);
+                solveSubgame(s);
+                tallyVotes(s, 1);
+                stale_subgames &= ~(1u << s);
+            }
+        }
+    }
+
+public:
+    GameSession3x3(const Game3x3& game)
+        : game3x3(game), stale_subgames(0), exact_valid(false), subgames_solved(0) {
+        outcome_votes.fill(0);
+        row_votes.fill(0);
+        col_votes.fill(0);
+        
+        // Same rectangle order and numbering as Game3x3Solver
+        solvers.reserve(countSubgames2x2(3, 3));
+        int s = 0;
+        for (int r1 = 0; r1 < 3; r1++) {
+            for (int c1 = 0; c1 < 3; c1++) {
+                for (int c2 = c1 + 1; c2 < 3; c2++) {
+                    for (int r2 = r1 + 1; r2 < 3; r2++) {
+                        analyses[s].submatrix = makeSubmatrix3x3(game3x3, r1, r2, c1, c2);
+                        analyses[s].submatrix_id = s + 1;
+                        solvers.emplace_back(analyses[s].submatrix.game);
+                        solveSubgame(s);
+                        tallyVotes(s, 1);
+                        s++;
+                    }
+                }
+            }
+        }
+        
+        BimatrixSolver<Game3x3> solver(game3x3);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                pure_flags[i * 3 + j] = solver.isPureNashEquilibrium(i, j);
+            }
+        }
+    }
+    
+    const Game3x3& getGame() const {
+        return game3x3;
+    }
+    
+    // Change one payoff and invalidate the data that depends on it; an
+    // out-of-range cell or player is ignored, as in Game::setPayoff
+    void setPayoff(int row, int col, int player, double payoff) {
+        if (row < 0 || row >= 3 || col < 0 || col >= 3 || player < 0 || player > 1) {
+            return;
+        }
+        game3x3.setPayoff(row, col, player, payoff);
+        exact_valid = false;
+        
+        // The subgames whose rectangle contains the cell
+        for (int s = 0; s < 9; s++) {
+            const array<pair<int, int>, 4>& positions = analyses[s].submatrix.positions;
+            int r1 = positions[0].first, c1 = positions[0].second;
+            int r2 = positions[3].first, c2 = positions[3].second;
+            if ((row == r1 || row == r2) && (col == c1 || col == c2)) {
+                solvers[s].setPayoff(row == r2 ? 1 : 0, col == c2 ? 1 : 0, player, payoff);
+                stale_subgames |= 1u << s;
+            }
+        }
+        
+        // Player 1's payoffs decide the flags of their column, player 2's those of their row
+        BimatrixSolver<Game3x3> solver(game3x3);
+        for (int k = 0; k < 3; k++) {
+            if (player == 0) {
+                pure_flags[k * 3 + col] = solver.isPureNashEquilibrium(k, col);
+            } else {
+                pure_flags[row * 3 + k] = solver.isPureNashEquilibrium(row, k);
+            }
+        }
+    }
+    
+    // Number of subgames waiting to be re-solved
+    int staleSubgames() const {
+        int count = 0;
+        for (int s = 0; s < 9; s++) {
+            count += (stale_subgames >> s) & 1;
+        }
+        return count;
+    }
+    
+    // Subgames solved since the session started, including the initial 9
+    uint64_t subgamesSolved() const {
+        return subgames_solved;
+    }
+    
+    // Analyses of all 2x2 subgames, as Game3x3Solver::analyzeAll2x2Submatrices
+    vector<SubmatrixAnalysis> analyzeAll2x2Submatrices() {
+        refresh();
+        return vector<SubmatrixAnalysis>(analyses.begin(), analyses.end());
+    }
+    
+    // Vote-based prediction, as Game3x3Solver::calculate3x3NMEFromSubgames
+    SubgamePrediction calculate3x3NMEFromSubgames() {
+        refresh();
+        GAMESOLVER_PHASE(Voting);
+        SubgamePrediction prediction;
+        for (const auto& analysis : analyses) {
+            for (const auto& nme : analysis.non_myopic_equilibria) {
+                prediction.votes.push_back(subgameVote(analysis, nme));
+            }
+        }
+        prediction.outcome_votes = outcome_votes;
+        prediction.row_votes = row_votes;
+        prediction.col_votes = col_votes;
+        prediction.max_votes = 0;
+        for (int votes : outcome_votes) {
+            prediction.max_votes = max(prediction.max_votes, votes);
+        }
+        prediction.num_subgames = (int)analyses.size();
+        return prediction;
+    }
+    
+    // Pure strategy Nash equilibria of the full game in row-major order
+    vector<PureProfile> findPureNashEquilibria() const {
+        vector<PureProfile> equilibria;
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                if (pure_flags[i * 3 + j]) {
+                    equilibria.emplace_back(i, j);
+                }
+            }
+        }
+        return equilibria;
+    }
+    
+    // Exact Nash equilibria of the full game, recomputed only after an edit
+    const vector<MixedEquilibrium>& findExactNashEquilibria() {
+        if (!exact_valid) {
+            exact_equilibria = NashEngine<Game3x3>(game3x3).supportEnumeration();
+            exact_valid = true;
+        }
+        return exact_equilibria;
+    }
+};
+
+#endif // GAME_SESSION_H
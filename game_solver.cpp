@@ -0,0 +1,723 @@
+#include "game_solver.h"
+#include "solver_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+// Intervals of the uniform grids of SolverMode::Grid
+const int kNashGridIntervals = 100;
+const int kNonMyopicGridIntervals = 20;
+
+// Precompute a player's best response correspondence
+void NormalFormSolver::buildBestResponseCache(int player) {
+    // Player 1's gain is linear in player 2's mix q, player 2's in player 1's mix p
+    BestResponseCache& br = best_response[player];
+    if (player == 0) {
+        br.gain_intercept = game.getPayoffUnchecked(0, 1, 0) - game.getPayoffUnchecked(1, 1, 0);
+        br.gain_slope = (game.getPayoffUnchecked(0, 0, 0) - game.getPayoffUnchecked(1, 0, 0)) - br.gain_intercept;
+    } else {
+        br.gain_intercept = game.getPayoffUnchecked(1, 0, 1) - game.getPayoffUnchecked(1, 1, 1);
+        br.gain_slope = (game.getPayoffUnchecked(0, 0, 1) - game.getPayoffUnchecked(0, 1, 1)) - br.gain_intercept;
+    }
+}
+
+// Calculate expected payoff for a player given strategy profile
+double NormalFormSolver::calculateExpectedPayoff(int player, const StrategyProfile& profile) const {
+    GAMESOLVER_COUNT(PayoffEvaluations, 1);
+    double expected_payoff = 0.0;
+    
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            double prob_i = (i == 0) ? profile.p1_strategy1_prob : (1 - profile.p1_strategy1_prob);
+            double prob_j = (j == 0) ? profile.p2_strategy1_prob : (1 - profile.p2_strategy1_prob);
+            double joint_prob = prob_i * prob_j;
+            expected_payoff += joint_prob * game.getPayoffUnchecked(i, j, player);
+        }
+    }
+    
+    return expected_payoff;
+}
+
+// Find best response for a player given the other player's strategy
+// Expected payoff is linear in the player's own mix, so the best response is
+// always pure; ties within tolerance go to strategy 2, as in a grid scan.
+double NormalFormSolver::findBestResponse(int player, double other_player_prob, double tolerance) const {
+    GAMESOLVER_COUNT(BestResponseCalls, 1);
+    return best_response[player].gain(other_player_prob) > tolerance ? 1.0 : 0.0;
+}
+
+// Check if a strategy profile is a Nash equilibrium
+bool NormalFormSolver::isNashEquilibrium(const StrategyProfile& profile, double tolerance) const {
+    // Check if player 1 is playing best response
+    double p1_best_response = findBestResponse(0, profile.p2_strategy1_prob, tolerance);
+    if (abs(profile.p1_strategy1_prob - p1_best_response) > tolerance) {
+        return false;
+    }
+    
+    // Check if player 2 is playing best response
+    double p2_best_response = findBestResponse(1, profile.p1_strategy1_prob, tolerance);
+    if (abs(profile.p2_strategy1_prob - p2_best_response) > tolerance) {
+        return false;
+    }
+    
+    return true;
+}
+
+// Find all pure strategy Nash equilibria
+vector<Equilibrium> NormalFormSolver::findPureNashEquilibria() const {
+    GAMESOLVER_PHASE(PureNash);
+    vector<Equilibrium> equilibria;
+    
+    BimatrixSolver<Game2x2> solver(game);
+    
+    // Check all four pure strategy combinations
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            StrategyProfile profile(i, j);
+            
+            // Check that neither player wants to deviate
+            if (solver.isPureNashEquilibrium(i, j)) {
+                equilibria.emplace_back(profile, EquilibriumKind::PureNash);
+            }
+        }
+    }
+    
+    return equilibria;
+}
+
+// Find mixed strategy Nash equilibria
+vector<Equilibrium> NormalFormSolver::findMixedNashEquilibria() const {
+    GAMESOLVER_PHASE(MixedNash);
+    vector<Equilibrium> equilibria;
+    
+    // Solve for player 1's mixed strategy that makes player 2 indifferent. The
+    // grid is indexed by integers so that it does not drift and reaches 1.0.
+    for (int k = 0; k <= kNashGridIntervals; k++) {
+        double p1 = (double)k / kNashGridIntervals;
+        GAMESOLVER_COUNT(GridPoints, 1);
+        GAMESOLVER_COUNT(PayoffEvaluations, 2);
+        
+        // Calculate player 2's expected payoff from strategy 1
+        double p2_strategy1_payoff = p1 * game.getPayoffUnchecked(0, 0, 1) + (1 - p1) * game.getPayoffUnchecked(1, 0, 1);
+        
+        // Calculate player 2's expected payoff from strategy 2
+        double p2_strategy2_payoff = p1 * game.getPayoffUnchecked(0, 1, 1) + (1 - p1) * game.getPayoffUnchecked(1, 1, 1);
+        
+        // If player 2 is indifferent, find player 2's best response
+        if (abs(p2_strategy1_payoff - p2_strategy2_payoff) < 0.01) {
+            double p2 = 0.5; // Indifferent player can play any mixed strategy
+            
+            StrategyProfile profile(p1, p2);
+            if (isNashEquilibrium(profile)) {
+                equilibria.emplace_back(profile, EquilibriumKind::MixedNash);
+            }
+        }
+    }
+    
+    return equilibria;
+}
+
+// Closed interval of probabilities; empty when lo > hi. The analytic helpers
+// below work on double, or on Rational for SolverMode::Exact.
+template<class Scalar>
+struct Interval {
+    Scalar lo;
+    Scalar hi;
+    
+    bool empty() const { return lo > hi; }
+};
+
+typedef Interval<double> ProbabilityInterval;
+
+// Root of intercept + slope * x for a non-zero slope, with -0.0 normalised to 0.0
+template<class Scalar>
+static Scalar linearRoot(const Scalar& intercept, const Scalar& slope) {
+    Scalar root = -intercept / slope;
+    return root == Scalar(0) ? Scalar(0) : root;
+}
+
+// Probabilities x in [0,1] with intercept + slope * x >= 0
+template<class Scalar>
+static Interval<Scalar> nonNegativeSet(const Scalar& intercept, const Scalar& slope) {
+    const Scalar zero(0), one(1);
+    if (slope == zero) {
+        return intercept >= zero ? Interval<Scalar>{zero, one} : Interval<Scalar>{one, zero};
+    }
+    Scalar root = linearRoot(intercept, slope);
+    if (slope > zero) {
+        return {max(zero, root), one};
+    }
+    return {zero, min(one, root)};
+}
+
+// Probabilities x in [0,1] with intercept + slope * x == 0
+template<class Scalar>
+static Interval<Scalar> zeroSet(const Scalar& intercept, const Scalar& slope) {
+    const Scalar zero(0), one(1);
+    if (slope == zero) {
+        return intercept == zero ? Interval<Scalar>{zero, one} : Interval<Scalar>{one, zero};
+    }
+    Scalar root = linearRoot(intercept, slope);
+    if (root >= zero && root <= one) {
+        return {root, root};
+    }
+    return {one, zero};
+}
+
+template<class Scalar>
+static Interval<Scalar> intersect(const Interval<Scalar>& a, const Interval<Scalar>& b) {
+    return {max(a.lo, b.lo), min(a.hi, b.hi)};
+}
+
+// Profile and equilibrium records built from a scalar type
+template<class Scalar>
+struct EquilibriumTypes;
+
+template<>
+struct EquilibriumTypes<double> {
+    typedef StrategyProfile Profile;
+    typedef Equilibrium Record;
+};
+
+template<>
+struct EquilibriumTypes<Rational> {
+    typedef ExactProfile Profile;
+    typedef ExactEquilibrium Record;
+};
+
+// Where a player's gain from strategy 1 over strategy 2 is non-negative,
+// non-positive and zero, as a function of the other player's mix
+template<class Scalar>
+struct GainSigns {
+    Interval<Scalar> non_negative;
+    Interval<Scalar> non_positive;
+    Interval<Scalar> zero;
+};
+
+// The sets for the gain intercept + slope * x
+template<class Scalar>
+static GainSigns<Scalar> linearGainSigns(const Scalar& intercept, const Scalar& slope) {
+    return {nonNegativeSet(intercept, slope), nonNegativeSet(-intercept, -slope), zeroSet(intercept, slope)};
+}
+
+// The same sets located by the adaptive grid search. The gain is linear, so
+// each set is a single interval, the hull of the runs of the wanted signs.
+static GainSigns<double> searchedGainSigns(const BestResponseCache& br, const GridSearchOptions& options) {
+    vector<SignRun> runs = findSignRuns([&br](double x) { return br.gain(x); }, options);
+    SignRun non_negative = signHull(runs, SIGN_POSITIVE | SIGN_ZERO);
+    SignRun non_positive = signHull(runs, SIGN_NEGATIVE | SIGN_ZERO);
+    SignRun zero = signHull(runs, SIGN_ZERO);
+    return {{non_negative.lo, non_negative.hi}, {non_positive.lo, non_positive.hi}, {zero.lo, zero.hi}};
+}
+
+// Mixed (and continuum) Nash equilibria from where each player's gain is
+// non-negative, non-positive and zero. Player 1's gain depends on player 2's
+// mix q, player 2's on player 1's mix p.
+template<class Scalar>
+static vector<typename EquilibriumTypes<Scalar>::Record> nashEquilibriaFromGainSigns(const GainSigns<Scalar>& p1_gain,
+                                                                                    const GainSigns<Scalar>& p2_gain) {
+    typedef Interval<Scalar> ProbabilityInterval;
+    typedef typename EquilibriumTypes<Scalar>::Profile Profile;
+    
+    // Each best response correspondence is a union of three closed boxes in (p, q):
+    // strategy 1, strategy 2, or any mix when indifferent
+    const ProbabilityInterval unit = {Scalar(0), Scalar(1)};
+    const ProbabilityInterval one = {Scalar(1), Scalar(1)};
+    const ProbabilityInterval zero = {Scalar(0), Scalar(0)};
+    ProbabilityInterval p1_boxes[3][2] = {
+        {one, p1_gain.non_negative},
+        {zero, p1_gain.non_positive},
+        {unit, p1_gain.zero}
+    };
+    ProbabilityInterval p2_boxes[3][2] = {
+        {p2_gain.non_negative, one},
+        {p2_gain.non_positive, zero},
+        {p2_gain.zero, unit}
+    };
+    
+    // The equilibrium set is the intersection of both correspondences
+    vector<pair<ProbabilityInterval, ProbabilityInterval>> boxes;
+    for (const auto& b1 : p1_boxes) {
+        for (const auto& b2 : p2_boxes) {
+            ProbabilityInterval p_range = intersect(b1[0], b2[0]);
+            ProbabilityInterval q_range = intersect(b1[1], b2[1]);
+            if (p_range.empty() || q_range.empty()) {
+                continue;
+            }
+            
+            // Isolated pure profiles are reported by findPureNashEquilibria
+            bool is_point = p_range.lo == p_range.hi && q_range.lo == q_range.hi;
+            bool is_corner = (p_range.lo == zero.lo || p_range.lo == one.lo) &&
+                             (q_range.lo == zero.lo || q_range.lo == one.lo);
+            if (is_point && is_corner) {
+                continue;
+            }
+            boxes.emplace_back(p_range, q_range);
+        }
+    }
+    
+    vector<typename EquilibriumTypes<Scalar>::Record> equilibria;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        // Drop boxes covered by another box (keeping the first of identical ones)
+        bool covered = false;
+        for (size_t j = 0; j < boxes.size() && !covered; j++) {
+            if (i == j) {
+                continue;
+            }
+            bool contains = boxes[j].first.lo <= boxes[i].first.lo && boxes[i].first.hi <= boxes[j].first.hi &&
+                            boxes[j].second.lo <= boxes[i].second.lo && boxes[i].second.hi <= boxes[j].second.hi;
+            bool identical = boxes[j].first.lo == boxes[i].first.lo && boxes[j].first.hi == boxes[i].first.hi &&
+                             boxes[j].second.lo == boxes[i].second.lo && boxes[j].second.hi == boxes[i].second.hi;
+            covered = contains && (!identical || j < i);
+        }
+        if (covered) {
+            continue;
+        }
+        
+        const ProbabilityInterval& p_range = boxes[i].first;
+        const ProbabilityInterval& q_range = boxes[i].second;
+        Profile lo(p_range.lo, q_range.lo);
+        Profile hi(p_range.hi, q_range.hi);
+        if (p_range.lo == p_range.hi && q_range.lo == q_range.hi) {
+            equilibria.emplace_back(lo, EquilibriumKind::MixedNash);
+        } else {
+            equilibria.emplace_back(lo, hi, EquilibriumKind::NashContinuum);
+        }
+    }
+    
+    return equilibria;
+}
+
+// Find mixed strategy Nash equilibria from the indifference equations
+vector<Equilibrium> NormalFormSolver::findMixedNashEquilibriaAnalytic() const {
+    GAMESOLVER_PHASE(MixedNash);
+    const BestResponseCache& p1 = best_response[0];
+    const BestResponseCache& p2 = best_response[1];
+    return nashEquilibriaFromGainSigns(linearGainSigns(p1.gain_intercept, p1.gain_slope),
+                                       linearGainSigns(p2.gain_intercept, p2.gain_slope));
+}
+
+// Find mixed strategy Nash equilibria with the indifference points located by
+// the adaptive grid search
+vector<Equilibrium> NormalFormSolver::findMixedNashEquilibriaAdaptive() const {
+    GAMESOLVER_PHASE(MixedNash);
+    return nashEquilibriaFromGainSigns(searchedGainSigns(best_response[0], grid_options),
+                                       searchedGainSigns(best_response[1], grid_options));
+}
+
+// Iterated elimination of strictly dominated strategies (see dominance.h) for a
+// 2x2 game. Returns true with the surviving cell if it leaves a single one.
+static bool solveByStrictDominance(const Game2x2& game, int& row, int& col) {
+    auto a = [&game](int i, int j) { return game.getPayoffUnchecked(i, j, 0); };
+    auto b = [&game](int i, int j) { return game.getPayoffUnchecked(i, j, 1); };
+    if (a(0, 0) > a(1, 0) && a(0, 1) > a(1, 1)) {
+        row = 0;
+    } else if (a(1, 0) > a(0, 0) && a(1, 1) > a(0, 1)) {
+        row = 1;
+    } else if (b(0, 0) > b(0, 1) && b(1, 0) > b(1, 1)) {
+        col = 0;
+    } else if (b(0, 1) > b(0, 0) && b(1, 1) > b(1, 0)) {
+        col = 1;
+    } else {
+        return false;
+    }
+    
+    // One strategy is left for one player; the other needs a strict best response to it
+    if (row >= 0) {
+        col = (b(row, 0) > b(row, 1)) ? 0 : (b(row, 1) > b(row, 0)) ? 1 : -1;
+        return col >= 0;
+    }
+    row = (a(0, col) > a(1, col)) ? 0 : (a(1, col) > a(0, col)) ? 1 : -1;
+    return row >= 0;
+}
+
+// Find all Nash equilibria (both pure and mixed)
+vector<Equilibrium> NormalFormSolver::findAllNashEquilibria(SolverMode mode) const {
+    vector<Equilibrium> all_equilibria;
+    if (mode == SolverMode::Exact) {
+        vector<ExactEquilibrium> exact;
+        if (findAllNashEquilibriaExact(exact)) {
+            for (const ExactEquilibrium& eq : exact) {
+                all_equilibria.push_back(eq.toEquilibrium());
+            }
+            return all_equilibria;
+        }
+        mode = SolverMode::Analytic;
+    }
+    
+    // A game solved by strict dominance has exactly one equilibrium, the surviving cell
+    int row = -1;
+    int col = -1;
+    if (mode != SolverMode::Grid && solveByStrictDominance(game, row, col)) {
+        all_equilibria.emplace_back(StrategyProfile(row, col), EquilibriumKind::PureNash);
+        return all_equilibria;
+    }
+    
+    // Find pure strategy equilibria
+    vector<Equilibrium> pure_equilibria = findPureNashEquilibria();
+    all_equilibria.insert(all_equilibria.end(), pure_equilibria.begin(), pure_equilibria.end());
+    
+    // Find mixed strategy equilibria
+    vector<Equilibrium> mixed_equilibria;
+    if (mode == SolverMode::Analytic) {
+        mixed_equilibria = findMixedNashEquilibriaAnalytic();
+    } else if (mode == SolverMode::Adaptive) {
+        mixed_equilibria = findMixedNashEquilibriaAdaptive();
+    } else {
+        mixed_equilibria = findMixedNashEquilibria();
+    }
+    all_equilibria.insert(all_equilibria.end(), mixed_equilibria.begin(), mixed_equilibria.end());
+    
+    return all_equilibria;
+}
+
+// Find NME
+vector<Equilibrium> NormalFormSolver::findNonMyopicEquilibria(SolverMode mode) const {
+    GAMESOLVER_PHASE(NonMyopic);
+    if (mode == SolverMode::Adaptive) {
+        return findNonMyopicEquilibriaAdaptive();
+    }
+    if (mode == SolverMode::Exact) {
+        // Non-finite payoffs have no exact value: fall back to the analytic solver
+        vector<ExactEquilibrium> exact;
+        if (findNonMyopicEquilibriaExact(exact)) {
+            vector<Equilibrium> non_myopic_equilibria;
+            for (const ExactEquilibrium& eq : exact) {
+                non_myopic_equilibria.push_back(eq.toEquilibrium());
+            }
+            return non_myopic_equilibria;
+        }
+        mode = SolverMode::Analytic;
+    }
+    return (mode == SolverMode::Analytic) ? findNonMyopicEquilibriaAnalytic() : findNonMyopicEquilibriaGrid();
+}
+
+// Range of a leader's mixing probability x together with the linear payoff the
+// leader anticipates on it: x * if_strategy1 + (1 - x) * if_strategy2
+template<class Scalar>
+struct AnticipatedPiece {
+    Interval<Scalar> range;
+    Scalar if_strategy1;
+    Scalar if_strategy2;
+};
+
+// Leader's anticipated payoff from a piece at mixing probability x
+template<class Scalar>
+static Scalar anticipatedValue(const AnticipatedPiece<Scalar>& piece, const Scalar& x) {
+    return x * piece.if_strategy1 + (Scalar(1) - x) * piece.if_strategy2;
+}
+
+// Mixing probabilities that maximize a leader's anticipated payoff. The follower
+// plays strategy 1 where its gain is non-negative and strategy 2 where it is
+// non-positive; leader_vs_follow1/2 hold the leader's payoffs from its
+// strategies 1 and 2 when the follower plays strategy 1/2.
+//
+// Where the follower is indifferent the leader cannot count on a favourable
+// tie-break. At an isolated indifference point the better piece's value is
+// only a supremum, approached from that piece's side: the point is kept when
+// nothing attains that value, which is the limit the grid search approaches
+// as it is refined, and dropped when another profile attains it or when the
+// piece has no other side. A follower indifferent everywhere leaves the
+// leader the worse of the two pieces.
+template<class Scalar>
+static vector<Interval<Scalar>> anticipatedArgmax(const GainSigns<Scalar>& follower_gain,
+                                                  const Scalar leader_vs_follow1[2],
+                                                  const Scalar leader_vs_follow2[2]) {
+    typedef Interval<Scalar> ProbabilityInterval;
+    
+    // The follower's best response is constant on each side of its indifference point
+    AnticipatedPiece<Scalar> follow1 = {follower_gain.non_negative, leader_vs_follow1[0], leader_vs_follow1[1]};
+    AnticipatedPiece<Scalar> follow2 = {follower_gain.non_positive, leader_vs_follow2[0], leader_vs_follow2[1]};
+    const ProbabilityInterval& ties = follower_gain.zero;
+    
+    if (!ties.empty() && ties.lo < ties.hi) {
+        // The minimum of two linear payoffs is concave, so its maximizers form
+        // an interval whose ends are among the range ends and the crossing point
+        vector<Scalar> points = {ties.lo, ties.hi};
+        Scalar slope = (follow1.if_strategy1 - follow1.if_strategy2) - (follow2.if_strategy1 - follow2.if_strategy2);
+        if (slope != Scalar(0)) {
+            Scalar crossing = linearRoot(follow1.if_strategy2 - follow2.if_strategy2, slope);
+            if (ties.lo < crossing && crossing < ties.hi) {
+                points.push_back(crossing);
+            }
+        }
+        auto worse = [&follow1, &follow2](const Scalar& x) {
+            return min(anticipatedValue(follow1, x), anticipatedValue(follow2, x));
+        };
+        Scalar best_value = worse(points[0]);
+        for (const Scalar& x : points) {
+            best_value = max(best_value, worse(x));
+        }
+        ProbabilityInterval best = {ties.hi, ties.lo};
+        for (const Scalar& x : points) {
+            if (worse(x) == best_value) {
+                best.lo = min(best.lo, x);
+                best.hi = max(best.hi, x);
+            }
+        }
+        return {best};
+    }
+    
+    struct Candidate {
+        ProbabilityInterval range;
+        Scalar value;
+        bool tie_only; // Attained only if the follower breaks its tie in the leader's favour
+    };
+    vector<Candidate> candidates;
+    const AnticipatedPiece<Scalar>* pieces[2] = {&follow1, &follow2};
+    for (int k = 0; k < 2; k++) {
+        const AnticipatedPiece<Scalar>& piece = *pieces[k];
+        const AnticipatedPiece<Scalar>& other = *pieces[1 - k];
+        if (piece.range.empty()) {
+            continue;
+        }
+        // A linear payoff peaks at one end of the range, or along all of it when flat
+        ProbabilityInterval best = piece.range;
+        if (piece.if_strategy1 > piece.if_strategy2) {
+            best.lo = best.hi;
+        } else if (piece.if_strategy1 < piece.if_strategy2) {
+            best.hi = best.lo;
+        }
+        Scalar value = anticipatedValue(piece, best.lo);
+        bool tie_only = best.lo == best.hi && !ties.empty() && best.lo == ties.lo &&
+                        anticipatedValue(other, best.lo) < value;
+        // A piece that is nothing but the tie neither attains nor approaches its value there
+        if (tie_only && piece.range.lo == piece.range.hi) {
+            continue;
+        }
+        candidates.push_back({best, value, tie_only});
+    }
+    
+    const Scalar* best_value = nullptr;
+    for (const auto& c : candidates) {
+        if (!best_value || *best_value < c.value) {
+            best_value = &c.value;
+        }
+    }
+    bool attained = false;
+    for (const auto& c : candidates) {
+        attained = attained || (!(c.value < *best_value) && !c.tie_only);
+    }
+    auto maximizes = [&best_value, attained](const Candidate& c) {
+        return !(c.value < *best_value) && !(attained && c.tie_only);
+    };
+    
+    vector<ProbabilityInterval> argmax;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (!maximizes(candidates[i])) {
+            continue;
+        }
+        // Drop a maximizer already covered by another one
+        bool covered = false;
+        for (size_t j = 0; j < candidates.size() && !covered; j++) {
+            if (i == j || !maximizes(candidates[j])) {
+                continue;
+            }
+            const ProbabilityInterval& a = candidates[i].range;
+            const ProbabilityInterval& b = candidates[j].range;
+            bool identical = a.lo == b.lo && a.hi == b.hi;
+            covered = b.lo <= a.lo && a.hi <= b.hi && (!identical || j < i);
+        }
+        if (!covered) {
+            argmax.push_back(candidates[i].range);
+        }
+    }
+    return argmax;
+}
+
+// Non-myopic equilibria of a game with the given payoffs, in Game2x2 order,
+// from where each player's gain from strategy 1 over strategy 2 is
+// non-negative, non-positive and zero
+template<class Scalar>
+static vector<typename EquilibriumTypes<Scalar>::Record> nonMyopicFromGainSigns(const array<Scalar, 8>& payoffs,
+                                                                               const GainSigns<Scalar>& p1_gain,
+                                                                               const GainSigns<Scalar>& p2_gain) {
+    typedef typename EquilibriumTypes<Scalar>::Profile Profile;
+    auto payoff = [&payoffs](int row, int col, int player) -> const Scalar& {
+        return payoffs[(row * 2 + col) * 2 + player];
+    };
+    
+    // Each player's condition depends only on its own mix: player 1 picks p to
+    // maximize its payoff given player 2's best response to p, and vice versa.
+    // Those payoffs are linear on each side of the opponent's indifference point.
+    const Scalar p1_vs_col1[2] = {payoff(0, 0, 0), payoff(1, 0, 0)};
+    const Scalar p1_vs_col2[2] = {payoff(0, 1, 0), payoff(1, 1, 0)};
+    vector<Interval<Scalar>> p1_best = anticipatedArgmax(p2_gain, p1_vs_col1, p1_vs_col2);
+    
+    const Scalar p2_vs_row1[2] = {payoff(0, 0, 1), payoff(0, 1, 1)};
+    const Scalar p2_vs_row2[2] = {payoff(1, 0, 1), payoff(1, 1, 1)};
+    vector<Interval<Scalar>> p2_best = anticipatedArgmax(p1_gain, p2_vs_row1, p2_vs_row2);
+    
+    vector<typename EquilibriumTypes<Scalar>::Record> non_myopic_equilibria;
+    for (const auto& p_range : p1_best) {
+        for (const auto& q_range : p2_best) {
+            Profile lo(p_range.lo, q_range.lo);
+            Profile hi(p_range.hi, q_range.hi);
+            if (p_range.lo == p_range.hi && q_range.lo == q_range.hi) {
+                non_myopic_equilibria.emplace_back(lo, EquilibriumKind::NonMyopic);
+            } else {
+                non_myopic_equilibria.emplace_back(lo, hi, EquilibriumKind::NonMyopic);
+            }
+        }
+    }
+    
+    return non_myopic_equilibria;
+}
+
+// Find non-myopic equilibria from the breakpoints of the anticipated payoffs
+vector<Equilibrium> NormalFormSolver::findNonMyopicEquilibriaAnalytic() const {
+    const BestResponseCache& p1 = best_response[0];
+    const BestResponseCache& p2 = best_response[1];
+    return nonMyopicFromGainSigns(game.payoffs, linearGainSigns(p1.gain_intercept, p1.gain_slope),
+                                  linearGainSigns(p2.gain_intercept, p2.gain_slope));
+}
+
+// Find non-myopic equilibria with the breakpoints of the anticipated payoffs
+// located by the adaptive grid search
+vector<Equilibrium> NormalFormSolver::findNonMyopicEquilibriaAdaptive() const {
+    return nonMyopicFromGainSigns(game.payoffs, searchedGainSigns(best_response[0], grid_options),
+                                  searchedGainSigns(best_response[1], grid_options));
+}
+
+// Find NME by grid search
+vector<Equilibrium> NormalFormSolver::findNonMyopicEquilibriaGrid() const {
+    vector<Equilibrium> non_myopic_equilibria;
+    
+    // Check all possible strategy profiles with finer granularity
+    for (int i = 0; i <= kNonMyopicGridIntervals; i++) {
+        double p1 = (double)i / kNonMyopicGridIntervals;
+        for (int j = 0; j <= kNonMyopicGridIntervals; j++) {
+            double p2 = (double)j / kNonMyopicGridIntervals;
+            GAMESOLVER_COUNT(GridPoints, 1);
+            StrategyProfile profile(p1, p2);
+            
+            // Check if this is NME
+            bool is_non_myopic = true;
+            
+            // Player 1 anticipates player 2's best response
+            double p2_best_response = findBestResponse(1, p1);
+            StrategyProfile anticipated_profile(p1, p2_best_response);
+            double p1_anticipated_payoff = calculateExpectedPayoff(0, anticipated_profile);
+            
+            // Check if player 1 can do better by deviating
+            for (int k = 0; k <= kNonMyopicGridIntervals; k++) {
+                double new_p1 = (double)k / kNonMyopicGridIntervals;
+                if (abs(new_p1 - p1) > 1e-6) {
+                    GAMESOLVER_COUNT(GridPoints, 1);
+                    double new_p2_best_response = findBestResponse(1, new_p1);
+                    StrategyProfile new_anticipated_profile(new_p1, new_p2_best_response);
+                    double new_p1_anticipated_payoff = calculateExpectedPayoff(0, new_anticipated_profile);
+                    
+                    if (new_p1_anticipated_payoff > p1_anticipated_payoff + 1e-6) {
+                        is_non_myopic = false;
+                        break;
+                    }
+                }
+            }
+            
+            if (is_non_myopic) {
+                // Player 2 anticipates player 1's best response
+                double p1_best_response = findBestResponse(0, p2);
+                StrategyProfile p2_anticipated_profile(p1_best_response, p2);
+                double p2_anticipated_payoff = calculateExpectedPayoff(1, p2_anticipated_profile);
+                
+                // Check if player 2 can do better by deviating
+                for (int k = 0; k <= kNonMyopicGridIntervals; k++) {
+                    double new_p2 = (double)k / kNonMyopicGridIntervals;
+                    if (abs(new_p2 - p2) > 1e-6) {
+                        GAMESOLVER_COUNT(GridPoints, 1);
+                        double new_p1_best_response = findBestResponse(0, new_p2);
+                        StrategyProfile new_p2_anticipated_profile(new_p1_best_response, new_p2);
+                        double new_p2_anticipated_payoff = calculateExpectedPayoff(1, new_p2_anticipated_profile);
+                        
+                        if (new_p2_anticipated_payoff > p2_anticipated_payoff + 1e-6) {
+                            is_non_myopic = false;
+                            break;
+                        }
+                    }
+                }
+            }
+            
+            if (is_non_myopic) {
+                non_myopic_equilibria.emplace_back(profile, EquilibriumKind::NonMyopic);
+            }
+        }
+    }
+    
+    return non_myopic_equilibria;
+}
+
+Equilibrium ExactEquilibrium::toEquilibrium() const {
+    StrategyProfile lo(profile.p1_strategy1_prob.toDouble(), profile.p2_strategy1_prob.toDouble());
+    if (!isContinuum) {
+        return Equilibrium(lo, kind);
+    }
+    StrategyProfile hi(profile_end.p1_strategy1_prob.toDouble(), profile_end.p2_strategy1_prob.toDouble());
+    return Equilibrium(lo, hi, kind);
+}
+
+// The payoffs of a game as exact rationals; false if one is not finite
+static bool exactPayoffs(const Game2x2& game, array<Rational, 8>& payoffs) {
+    for (size_t i = 0; i < payoffs.size(); i++) {
+        if (!Rational::fromDouble(game.payoffs[i], payoffs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Where a player's gain from strategy 1 over strategy 2 has each sign, in
+// exact arithmetic (see buildBestResponseCache)
+static GainSigns<Rational> exactGainSigns(const array<Rational, 8>& payoffs, int player) {
+    auto payoff = [&payoffs](int row, int col, int p) -> const Rational& { return payoffs[(row * 2 + col) * 2 + p]; };
+    Rational intercept, slope;
+    if (player == 0) {
+        intercept = payoff(0, 1, 0) - payoff(1, 1, 0);
+        slope = (payoff(0, 0, 0) - payoff(1, 0, 0)) - intercept;
+    } else {
+        intercept = payoff(1, 0, 1) - payoff(1, 1, 1);
+        slope = (payoff(0, 0, 1) - payoff(0, 1, 1)) - intercept;
+    }
+    return linearGainSigns(intercept, slope);
+}
+
+// Find all Nash equilibria in exact arithmetic. Pure equilibria and dominance
+// only compare payoffs, which is exact in double already.
+bool NormalFormSolver::findAllNashEquilibriaExact(vector<ExactEquilibrium>& equilibria) const {
+    array<Rational, 8> payoffs;
+    if (!exactPayoffs(game, payoffs)) {
+        return false;
+    }
+    equilibria.clear();
+    
+    int row = -1;
+    int col = -1;
+    if (solveByStrictDominance(game, row, col)) {
+        equilibria.emplace_back(ExactProfile(row, col), EquilibriumKind::PureNash);
+        return true;
+    }
+    
+    for (const Equilibrium& eq : findPureNashEquilibria()) {
+        ExactProfile profile((int64_t)eq.profile.p1_strategy1_prob, (int64_t)eq.profile.p2_strategy1_prob);
+        equilibria.emplace_back(profile, EquilibriumKind::PureNash);
+    }
+    
+    GAMESOLVER_PHASE(MixedNash);
+    vector<ExactEquilibrium> mixed = nashEquilibriaFromGainSigns(exactGainSigns(payoffs, 0),
+                                                                 exactGainSigns(payoffs, 1));
+    equilibria.insert(equilibria.end(), mixed.begin(), mixed.end());
+    return true;
+}
+
+// Find non-myopic equilibria in exact arithmetic
+bool NormalFormSolver::findNonMyopicEquilibriaExact(vector<ExactEquilibrium>& equilibria) const {
+    array<Rational, 8> payoffs;
+    if (!exactPayoffs(game, payoffs)) {
+        return false;
+    }
+    equilibria = nonMyopicFromGainSigns(payoffs, exactGainSigns(payoffs, 0), exactGainSigns(payoffs, 1));
+    return true;
+}
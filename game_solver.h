@@ -2,38 +2,20 @@
 #define GAME_SOLVER_H
 
 #include <iostream>
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <iomanip>
 #include <cmath>
-#include <sstream>
+#include "adaptive_grid.h"
+#include "bimatrix_game.h"
+#include "rational.h"
 
 using namespace std;
 
 // Structure to represent a 2x2 normal form game
-struct Game2x2 {
-    vector<vector<vector<double>>> payoffs; // [position][player][strategy]
-    
-    Game2x2() {
-        // Initialize 2x2x2x2 structure: [row][col][player][strategy]
-        payoffs = vector<vector<vector<double>>>(2, vector<vector<double>>(2, vector<double>(2, 0.0)));
-    }
-    
-    // Set payoff for a specific outcome
-    void setPayoff(int row, int col, int player, double payoff) {
-        if (row >= 0 && row < 2 && col >= 0 && col < 2 && player >= 0 && player < 2) {
-            payoffs[row][col][player] = payoff;
-        }
-    }
-    
-    // Get payoff for a specific outcome
-    double getPayoff(int row, int col, int player) const {
-        if (row >= 0 && row < 2 && col >= 0 && col < 2 && player >= 0 && player < 2) {
-            return payoffs[row][col][player];
-        }
-        return 0.0;
-    }
-};
+typedef Game<2, 2> Game2x2;
 
 // Structure to represent a strategy profile
 struct StrategyProfile {
@@ -43,19 +25,95 @@ struct StrategyProfile {
     StrategyProfile(double p1 = 0.5, double p2 = 0.5) : p1_strategy1_prob(p1), p2_strategy1_prob(p2) {}
 };
 
+// Kind of equilibrium stored in an Equilibrium record
+enum class EquilibriumKind : uint8_t {
+    PureNash,      // Isolated pure strategy Nash equilibrium
+    MixedNash,     // Isolated mixed strategy Nash equilibrium
+    NashContinuum, // Box of Nash equilibria
+    NonMyopic      // Non-myopic equilibrium (an isolated profile or a box)
+};
+
 // Structure to represent an equilibrium
+// A continuum of equilibria is stored as the axis-aligned box spanned by
+// profile and profile_end; for an isolated equilibrium both are equal.
+// Records hold no text: see game_report.h for formatting.
 struct Equilibrium {
     StrategyProfile profile;
+    StrategyProfile profile_end;
+    EquilibriumKind kind;
     bool isPure;
-    string description;
+    bool isContinuum;
+    
+    Equilibrium(const StrategyProfile& p, EquilibriumKind k = EquilibriumKind::MixedNash)
+        : profile(p), profile_end(p), kind(k), isPure(k == EquilibriumKind::PureNash), isContinuum(false) {}
+    
+    Equilibrium(const StrategyProfile& lo, const StrategyProfile& hi, EquilibriumKind k)
+        : profile(lo), profile_end(hi), kind(k), isPure(false), isContinuum(true) {}
+};
+
+// Strategy profile with exact rational probabilities
+struct ExactProfile {
+    Rational p1_strategy1_prob;
+    Rational p2_strategy1_prob;
+    
+    ExactProfile(const Rational& p1 = Rational(1, 2), const Rational& p2 = Rational(1, 2))
+        : p1_strategy1_prob(p1), p2_strategy1_prob(p2) {}
+};
+
+// Equilibrium with exact rational coordinates, as found by the exact solver;
+// the fields mean the same as in Equilibrium
+struct ExactEquilibrium {
+    ExactProfile profile;
+    ExactProfile profile_end;
+    EquilibriumKind kind;
+    bool isPure;
+    bool isContinuum;
+    
+    ExactEquilibrium(const ExactProfile& p, EquilibriumKind k = EquilibriumKind::MixedNash)
+        : profile(p), profile_end(p), kind(k), isPure(k == EquilibriumKind::PureNash), isContinuum(false) {}
+    
+    ExactEquilibrium(const ExactProfile& lo, const ExactProfile& hi, EquilibriumKind k)
+        : profile(lo), profile_end(hi), kind(k), isPure(false), isContinuum(true) {}
+    
+    // The same equilibrium with each probability rounded to the nearest double
+    Equilibrium toEquilibrium() const;
+};
+
+// Algorithm used to locate equilibria
+enum class SolverMode {
+    Grid,     // Uniform grid search over mixed strategies (approximate)
+    Analytic, // Closed-form solution of the indifference equations (exact)
+    Adaptive, // Indifference points located by an adaptive grid search to GridSearchOptions::precision
+    Exact     // Closed-form solution in rational arithmetic, rounded to double at the end
+};
+
+// Best response correspondence of one player, precomputed once per game.
+// The player's gain from strategy 1 over strategy 2 is linear in the other
+// player's probability x of playing strategy 1, so the best response is
+// constant on each side of a single indifference point. Its intercept and
+// slope determine both, so a best response lookup is one multiply-add and a
+// comparison, and the analytic solvers read the indifference point from them.
+struct BestResponseCache {
+    double gain_intercept;
+    double gain_slope;
     
-    Equilibrium(const StrategyProfile& p, bool pure = false, const string& desc = "") 
-        : profile(p), isPure(pure), description(desc) {}
+    // Gain from strategy 1 over strategy 2 when the other player plays strategy 1 with probability x
+    double gain(double x) const {
+        return gain_intercept + gain_slope * x;
+    }
 };
 
 class NormalFormSolver {
 private:
+    // Gives the benchmarks (bench_games.cpp) access to the individual solver stages
+    friend struct NormalFormSolverAccess;
+    
     Game2x2 game;
+    BestResponseCache best_response[2];
+    GridSearchOptions grid_options;
+    
+    // Precompute a player's best response correspondence, which depends only on that player's payoffs
+    void buildBestResponseCache(int player);
     
     // Calculate expected payoff for a player given strategy profile
     double calculateExpectedPayoff(int player, const StrategyProfile& profile) const;
@@ -71,18 +129,68 @@ private:
     
     // Find mixed strategy Nash equilibria
     vector<Equilibrium> findMixedNashEquilibria() const;
+    
+    // Find mixed strategy Nash equilibria from the indifference equations
+    vector<Equilibrium> findMixedNashEquilibriaAnalytic() const;
+    
+    // Find mixed strategy Nash equilibria by adaptive grid search
+    vector<Equilibrium> findMixedNashEquilibriaAdaptive() const;
+    
+    // Find non-myopic equilibria by grid search over strategy profiles
+    vector<Equilibrium> findNonMyopicEquilibriaGrid() const;
+    
+    // Find non-myopic equilibria from the breakpoints of the anticipated payoffs
+    vector<Equilibrium> findNonMyopicEquilibriaAnalytic() const;
+    
+    // Find non-myopic equilibria by adaptive grid search
+    vector<Equilibrium> findNonMyopicEquilibriaAdaptive() const;
 
 public:
-    NormalFormSolver(const Game2x2& g) : game(g) {}
+    NormalFormSolver(const Game2x2& g) : game(g) {
+        buildBestResponseCache(0);
+        buildBestResponseCache(1);
+    }
+    
+    // Change one payoff; only the best response cache of that player is
+    // rebuilt. An out-of-range cell or player is ignored, as in Game::setPayoff.
+    void setPayoff(int row, int col, int player, double payoff) {
+        if (row < 0 || row > 1 || col < 0 || col > 1 || player < 0 || player > 1) {
+            return;
+        }
+        game.setPayoff(row, col, player, payoff);
+        buildBestResponseCache(player);
+    }
+    
+    // Precomputed best response correspondence of a player (0 or 1)
+    const BestResponseCache& getBestResponseCache(int player) const {
+        return best_response[player];
+    }
+    
+    // Resolution of SolverMode::Adaptive
+    void setGridSearchOptions(const GridSearchOptions& options) {
+        grid_options = options;
+    }
+    
+    const GridSearchOptions& getGridSearchOptions() const {
+        return grid_options;
+    }
     
     // Find all Nash equilibria (both pure and mixed)
-    vector<Equilibrium> findAllNashEquilibria() const;
+    vector<Equilibrium> findAllNashEquilibria(SolverMode mode = SolverMode::Analytic) const;
     
     // Find non-myopic equilibrium (players look ahead and anticipate best responses)
-    vector<Equilibrium> findNonMyopicEquilibria() const;
+    vector<Equilibrium> findNonMyopicEquilibria(SolverMode mode = SolverMode::Analytic) const;
+    
+    // Exact equilibria with rational probabilities, in the order of the double
+    // overloads. Payoffs are taken at their exact binary values, so no
+    // comparison needs a tolerance. Returns false if a payoff is not finite.
+    bool findAllNashEquilibriaExact(vector<ExactEquilibrium>& equilibria) const;
+    bool findNonMyopicEquilibriaExact(vector<ExactEquilibrium>& equilibria) const;
     
-    // Print the game matrix
-    void printGame() const;
+    // The game being solved
+    const Game2x2& getGame() const {
+        return game;
+    }
 };
 
 #endif // GAME_SOLVER_H
@@ -0,0 +1,395 @@
+#ifndef NASH_ENGINE_H
+#define NASH_ENGINE_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "bimatrix_game.h"
+#include "dominance.h"
+
+using namespace std;
+
+// Structure to represent a mixed strategy Nash equilibrium of a bimatrix game
+struct MixedEquilibrium {
+    vector<double> row_strategy; // Probability of each row for player 1
+    vector<double> col_strategy; // Probability of each column for player 2
+    double row_payoff;
+    double col_payoff;
+    
+    MixedEquilibrium() : row_payoff(0.0), col_payoff(0.0) {}
+};
+
+// Solve the square system m * x = rhs in place by Gaussian elimination with
+// partial pivoting. m is row-major n x n. Returns false if m is singular.
+inline bool solveLinearSystem(vector<double>& m, vector<double>& rhs, int n, double tolerance = 1e-12) {
+    for (int col = 0; col < n; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < n; r++) {
+            if (abs(m[r * n + col]) > abs(m[pivot * n + col])) {
+                pivot = r;
+            }
+        }
+        if (abs(m[pivot * n + col]) < tolerance) {
+            return false;
+        }
+        if (pivot != col) {
+            for (int k = 0; k < n; k++) {
+                swap(m[pivot * n + k], m[col * n + k]);
+            }
+            swap(rhs[pivot], rhs[col]);
+        }
+        for (int r = col + 1; r < n; r++) {
+            double factor = m[r * n + col] / m[col * n + col];
+            if (factor == 0.0) {
+                continue;
+            }
+            for (int k = col; k < n; k++) {
+                m[r * n + k] -= factor * m[col * n + k];
+            }
+            rhs[r] -= factor * rhs[col];
+        }
+    }
+    for (int r = n - 1; r >= 0; r--) {
+        double sum = rhs[r];
+        for (int k = r + 1; k < n; k++) {
+            sum -= m[r * n + k] * rhs[k];
+        }
+        rhs[r] = sum / m[r * n + r];
+    }
+    return true;
+}
+
+// Exact Nash equilibrium engine for bimatrix games of any size.
+// supportEnumeration() finds every equilibrium of a nondegenerate game by
+// solving the indifference equations on each pair of equal-size supports;
+// lemkeHowson() follows a complementary pivoting path to one equilibrium and
+// is the method of choice when only a sample equilibrium is needed.
+template<class GameT>
+class NashEngine {
+private:
+    // lemkeHowson() runs the path on the reduced game through another instantiation
+    template<class> friend class NashEngine;
+    
+    const GameT& game;
+    DominanceMode dominance;
+    
+    // Advance a sorted k-subset of candidates to the next one in lexicographic order
+    static bool nextSubset(vector<int>& idx, int n) {
+        int k = idx.size();
+        for (int pos = k - 1; pos >= 0; pos--) {
+            if (idx[pos] < n - k + pos) {
+                idx[pos]++;
+                for (int q = pos + 1; q < k; q++) {
+                    idx[q] = idx[q - 1] + 1;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Solve for the opponent mix on `support` that makes `player` indifferent across `own`.
+    // For player 1 this finds the column mix; for player 2 the row mix.
+    bool solveIndifference(int player, const vector<int>& own, const vector<int>& support,
+                           vector<double>& mix, double& value, double tolerance) const {
+        int k = own.size();
+        int n = k + 1;
+        vector<double> m(n * n, 0.0);
+        vector<double> rhs(n, 0.0);
+        
+        // Rows 0..k-1: sum_s payoff(own, s) * mix_s - value = 0; row k: sum_s mix_s = 1
+        for (int a = 0; a < k; a++) {
+            for (int b = 0; b < k; b++) {
+                m[a * n + b] = (player == 0) ? game.getPayoffUnchecked(own[a], support[b], 0)
+                                             : game.getPayoffUnchecked(support[b], own[a], 1);
+            }
+            m[a * n + k] = -1.0;
+        }
+        for (int b = 0; b < k; b++) {
+            m[k * n + b] = 1.0;
+        }
+        rhs[k] = 1.0;
+        
+        if (!solveLinearSystem(m, rhs, n)) {
+            return false;
+        }
+        for (int b = 0; b < k; b++) {
+            if (rhs[b] < -tolerance) {
+                return false;
+            }
+        }
+        mix.assign(rhs.begin(), rhs.begin() + k);
+        value = rhs[k];
+        return true;
+    }
+    
+    // Check whether two equilibria agree within tolerance
+    static bool sameEquilibrium(const MixedEquilibrium& a, const MixedEquilibrium& b, double tolerance) {
+        for (size_t i = 0; i < a.row_strategy.size(); i++) {
+            if (abs(a.row_strategy[i] - b.row_strategy[i]) > tolerance) {
+                return false;
+            }
+        }
+        for (size_t j = 0; j < a.col_strategy.size(); j++) {
+            if (abs(a.col_strategy[j] - b.col_strategy[j]) > tolerance) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Pivot a tableau (rows x width, rhs in the last column) on (pivot_row, pivot_col)
+    static void pivot(vector<double>& tableau, int rows, int width, int pivot_row, int pivot_col) {
+        double pivot_value = tableau[pivot_row * width + pivot_col];
+        for (int k = 0; k < width; k++) {
+            tableau[pivot_row * width + k] /= pivot_value;
+        }
+        for (int r = 0; r < rows; r++) {
+            if (r == pivot_row) {
+                continue;
+            }
+            double factor = tableau[r * width + pivot_col];
+            if (factor == 0.0) {
+                continue;
+            }
+            for (int k = 0; k < width; k++) {
+                tableau[r * width + k] -= factor * tableau[pivot_row * width + k];
+            }
+        }
+    }
+    
+    // Lexicographic minimum ratio test on column `col`; the columns
+    // [basis_begin, basis_begin + rows) hold the initial slack basis
+    static int minRatioRow(const vector<double>& tableau, int rows, int width, int col, int basis_begin, double tolerance) {
+        int best = -1;
+        for (int r = 0; r < rows; r++) {
+            double coef = tableau[r * width + col];
+            if (coef <= tolerance) {
+                continue;
+            }
+            if (best < 0) {
+                best = r;
+                continue;
+            }
+            double best_coef = tableau[best * width + col];
+            double diff = tableau[r * width + width - 1] / coef - tableau[best * width + width - 1] / best_coef;
+            for (int k = 0; k < rows && abs(diff) <= tolerance; k++) {
+                diff = tableau[r * width + basis_begin + k] / coef - tableau[best * width + basis_begin + k] / best_coef;
+            }
+            if (diff < -tolerance) {
+                best = r;
+            }
+        }
+        return best;
+    }
+
+public:
+    // Dominated strategies are eliminated according to mode before solving
+    NashEngine(const GameT& g, DominanceMode mode = DominanceMode::Strict) : game(g), dominance(mode) {}
+    
+    // Find all Nash equilibria of a nondegenerate game by support enumeration.
+    // Strategies removed by iterated strict dominance never carry weight in an
+    // equilibrium, so supports containing them are skipped. With weak dominance
+    // only the equilibria of the reduced game are found.
+    vector<MixedEquilibrium> supportEnumeration(double tolerance = 1e-9) const {
+        int rows = game.rows();
+        int cols = game.cols();
+        DominanceReduction reduction = eliminateDominatedStrategies(game, dominance);
+        const vector<int>& live_rows = reduction.row_map;
+        const vector<int>& live_cols = reduction.col_map;
+        
+        vector<MixedEquilibrium> equilibria;
+        BimatrixSolver<GameT> solver(game);
+        int max_size = min(live_rows.size(), live_cols.size());
+        for (int k = 1; k <= max_size; k++) {
+            vector<int> row_idx(k), col_idx(k);
+            for (int a = 0; a < k; a++) row_idx[a] = a;
+            do {
+                vector<int> row_support(k);
+                for (int a = 0; a < k; a++) row_support[a] = live_rows[row_idx[a]];
+                
+                for (int a = 0; a < k; a++) col_idx[a] = a;
+                do {
+                    vector<int> col_support(k);
+                    for (int a = 0; a < k; a++) col_support[a] = live_cols[col_idx[a]];
+                    
+                    vector<double> col_mix, row_mix;
+                    double row_value, col_value;
+                    if (!solveIndifference(0, row_support, col_support, col_mix, row_value, tolerance) ||
+                        !solveIndifference(1, col_support, row_support, row_mix, col_value, tolerance)) {
+                        continue;
+                    }
+                    
+                    MixedEquilibrium eq;
+                    eq.row_strategy.assign(rows, 0.0);
+                    eq.col_strategy.assign(cols, 0.0);
+                    for (int a = 0; a < k; a++) {
+                        eq.row_strategy[row_support[a]] = max(0.0, row_mix[a]);
+                        eq.col_strategy[col_support[a]] = max(0.0, col_mix[a]);
+                    }
+                    
+                    // No strategy outside the supports may do better
+                    if (!solver.isNashEquilibrium(eq.row_strategy.data(), eq.col_strategy.data(), 1e-9 + tolerance)) {
+                        continue;
+                    }
+                    
+                    bool duplicate = false;
+                    for (const auto& existing : equilibria) {
+                        if (sameEquilibrium(existing, eq, 1e-7)) {
+                            duplicate = true;
+                            break;
+                        }
+                    }
+                    if (duplicate) {
+                        continue;
+                    }
+                    
+                    eq.row_payoff = solver.expectedPayoff(0, eq.row_strategy.data(), eq.col_strategy.data());
+                    eq.col_payoff = solver.expectedPayoff(1, eq.row_strategy.data(), eq.col_strategy.data());
+                    equilibria.push_back(eq);
+                } while (nextSubset(col_idx, live_cols.size()));
+            } while (nextSubset(row_idx, live_rows.size()));
+        }
+        
+        return equilibria;
+    }
+    
+    // Find one Nash equilibrium with the Lemke-Howson algorithm, dropping
+    // `initial_label` (0..rows-1 for a row, rows..rows+cols-1 for a column).
+    // Returns false if the path does not terminate within the pivot limit.
+    // Dominated strategies are eliminated first and the path is followed in the
+    // reduced game; if the dropped label's strategy was eliminated, the first
+    // surviving strategy of the same player is dropped instead.
+    bool lemkeHowson(MixedEquilibrium& result, int initial_label = 0, int max_pivots = 100000) const {
+        DominanceReduction reduction = eliminateDominatedStrategies(game, dominance);
+        if (!reduction.reduced()) {
+            return lemkeHowsonPath(result, initial_label, max_pivots);
+        }
+        
+        int rows = game.rows();
+        const vector<int>& row_map = reduction.row_map;
+        const vector<int>& col_map = reduction.col_map;
+        int label = 0;
+        if (initial_label < rows) {
+            label = (int)(lower_bound(row_map.begin(), row_map.end(), initial_label) - row_map.begin());
+            label = (label < (int)row_map.size() && row_map[label] == initial_label) ? label : 0;
+        } else {
+            int col = (int)(lower_bound(col_map.begin(), col_map.end(), initial_label - rows) - col_map.begin());
+            label = (int)row_map.size() +
+                    ((col < (int)col_map.size() && col_map[col] == initial_label - rows) ? col : 0);
+        }
+        
+        DynamicGame reduced = reducedGame(game, reduction);
+        MixedEquilibrium reduced_eq;
+        if (!NashEngine<DynamicGame>(reduced, DominanceMode::None).lemkeHowsonPath(reduced_eq, label, max_pivots)) {
+            return false;
+        }
+        
+        // Map back to the original strategies
+        result.row_strategy.assign(rows, 0.0);
+        result.col_strategy.assign(game.cols(), 0.0);
+        for (size_t a = 0; a < row_map.size(); a++) {
+            result.row_strategy[row_map[a]] = reduced_eq.row_strategy[a];
+        }
+        for (size_t b = 0; b < col_map.size(); b++) {
+            result.col_strategy[col_map[b]] = reduced_eq.col_strategy[b];
+        }
+        result.row_payoff = reduced_eq.row_payoff;
+        result.col_payoff = reduced_eq.col_payoff;
+        return true;
+    }
+
+
+private:
+    // Lemke-Howson on the full game, without elimination
+    bool lemkeHowsonPath(MixedEquilibrium& result, int initial_label, int max_pivots) const {
+        const double tolerance = 1e-12;
+        int rows = game.rows();
+        int cols = game.cols();
+        int labels = rows + cols;
+        int width = labels + 1;
+        
+        // Shift payoffs so both matrices are strictly positive; equilibria are unchanged
+        double min_payoff = INFINITY;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                min_payoff = min(min_payoff, min(game.getPayoffUnchecked(i, j, 0), game.getPayoffUnchecked(i, j, 1)));
+            }
+        }
+        double shift = 1.0 - min_payoff;
+        
+        // Tableau A (rows equations): r_i + sum_j A_ij y_j = 1, columns indexed by label
+        // Tableau B (cols equations): s_j + sum_i B_ij x_i = 1
+        vector<double> tab_a(rows * width, 0.0), tab_b(cols * width, 0.0);
+        vector<int> basis_a(rows), basis_b(cols);
+        for (int i = 0; i < rows; i++) {
+            tab_a[i * width + i] = 1.0;
+            for (int j = 0; j < cols; j++) {
+                tab_a[i * width + rows + j] = game.getPayoffUnchecked(i, j, 0) + shift;
+            }
+            tab_a[i * width + labels] = 1.0;
+            basis_a[i] = i;
+        }
+        for (int j = 0; j < cols; j++) {
+            for (int i = 0; i < rows; i++) {
+                tab_b[j * width + i] = game.getPayoffUnchecked(i, j, 1) + shift;
+            }
+            tab_b[j * width + rows + j] = 1.0;
+            tab_b[j * width + labels] = 1.0;
+            basis_b[j] = rows + j;
+        }
+        
+        // x_i and s_j live in tableau B, y_j and r_i in tableau A
+        int entering = initial_label;
+        bool in_b = initial_label < rows;
+        for (int step = 0; step < max_pivots; step++) {
+            vector<double>& tab = in_b ? tab_b : tab_a;
+            vector<int>& basis = in_b ? basis_b : basis_a;
+            int tab_rows = in_b ? cols : rows;
+            int basis_begin = in_b ? rows : 0;
+            
+            int row = minRatioRow(tab, tab_rows, width, entering, basis_begin, tolerance);
+            if (row < 0) {
+                return false;
+            }
+            int leaving = basis[row];
+            basis[row] = entering;
+            pivot(tab, tab_rows, width, row, entering);
+            
+            if (leaving == initial_label) {
+                result.row_strategy.assign(rows, 0.0);
+                result.col_strategy.assign(cols, 0.0);
+                double row_sum = 0.0, col_sum = 0.0;
+                for (int r = 0; r < cols; r++) {
+                    if (basis_b[r] < rows) {
+                        result.row_strategy[basis_b[r]] = tab_b[r * width + labels];
+                        row_sum += tab_b[r * width + labels];
+                    }
+                }
+                for (int r = 0; r < rows; r++) {
+                    if (basis_a[r] >= rows) {
+                        result.col_strategy[basis_a[r] - rows] = tab_a[r * width + labels];
+                        col_sum += tab_a[r * width + labels];
+                    }
+                }
+                if (row_sum <= 0.0 || col_sum <= 0.0) {
+                    return false;
+                }
+                for (auto& p : result.row_strategy) p /= row_sum;
+                for (auto& p : result.col_strategy) p /= col_sum;
+                
+                BimatrixSolver<GameT> solver(game);
+                result.row_payoff = solver.expectedPayoff(0, result.row_strategy.data(), result.col_strategy.data());
+                result.col_payoff = solver.expectedPayoff(1, result.row_strategy.data(), result.col_strategy.data());
+                return true;
+            }
+            
+            // The complement of the leaving variable enters the other tableau
+            entering = leaving;
+            in_b = !in_b;
+        }
+        return false;
+    }
+};
+
+#endif // NASH_ENGINE_H
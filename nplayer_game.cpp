@@ -0,0 +1,385 @@
+#include "nplayer_game.h"
+#include "nash_engine.h"
+#include "solver_stats.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+void NPlayerSolver::contract(int player, const vector<vector<double>>& mixes, uint64_t keep,
+                             vector<double>& result) const {
+    GAMESOLVER_COUNT(PayoffEvaluations, 1);
+    // Reused by every call on this thread; the two buffers alternate as source and target
+    static thread_local vector<double> buffers[2];
+    const double* source = game.playerPayoffs(player);
+    int target = 0;
+    
+    // Axes are contracted from the last (contiguous) one to the first. Before
+    // axis a the tensor is [axes 0..a][kept axes after a], i.e. outer x n x trailing.
+    size_t outer = game.num_profiles;
+    size_t trailing = 1;
+    for (int a = game.numPlayers() - 1; a >= 0; a--) {
+        size_t n = (size_t)game.num_strategies[a];
+        outer /= n;
+        if (keep & (1ULL << a)) {
+            trailing *= n;
+            continue;
+        }
+        
+        vector<double>& out = buffers[target];
+        out.assign(outer * trailing, 0.0);
+        const double* weights = mixes[a].data();
+        if (trailing == 1) {
+            for (size_t o = 0; o < outer; o++) {
+                const double* line = source + o * n;
+                double sum = 0.0;
+                for (size_t j = 0; j < n; j++) {
+                    sum += weights[j] * line[j];
+                }
+                out[o] = sum;
+            }
+        } else {
+            for (size_t o = 0; o < outer; o++) {
+                double* row = out.data() + o * trailing;
+                for (size_t j = 0; j < n; j++) {
+                    double weight = weights[j];
+                    // Off-support strategies are skipped, so pure and sparse mixes are cheap
+                    if (weight == 0.0) {
+                        continue;
+                    }
+                    const double* slice = source + (o * n + j) * trailing;
+                    for (size_t t = 0; t < trailing; t++) {
+                        row[t] += weight * slice[t];
+                    }
+                }
+            }
+        }
+        source = out.data();
+        target ^= 1;
+    }
+    result.assign(source, source + trailing);
+}
+
+double NPlayerSolver::expectedPayoff(const vector<vector<double>>& mixes, int player) const {
+    vector<double> result;
+    contract(player, mixes, 0, result);
+    return result[0];
+}
+
+void NPlayerSolver::deviationPayoffs(const vector<vector<double>>& mixes, int player, vector<double>& payoffs) const {
+    contract(player, mixes, 1ULL << player, payoffs);
+}
+
+bool NPlayerSolver::isNashEquilibrium(const vector<vector<double>>& mixes, double tolerance) const {
+    vector<double> payoffs;
+    for (int p = 0; p < game.numPlayers(); p++) {
+        deviationPayoffs(mixes, p, payoffs);
+        double value = 0.0;
+        for (int s = 0; s < game.numStrategies(p); s++) {
+            value += mixes[p][s] * payoffs[s];
+        }
+        for (int s = 0; s < game.numStrategies(p); s++) {
+            if (payoffs[s] > value + tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+vector<vector<int>> NPlayerSolver::findPureNashEquilibria() const {
+    GAMESOLVER_PHASE(PureNash);
+    int players = game.numPlayers();
+    vector<vector<int>> equilibria;
+    if (players == 0 || game.num_profiles == 0) {
+        return equilibria;
+    }
+    
+    // best_count[i]: players for whom profile i is a best response
+    vector<int> best_count(game.num_profiles, 0);
+    for (int p = 0; p < players; p++) {
+        const double* block = game.playerPayoffs(p);
+        size_t n = (size_t)game.num_strategies[p];
+        size_t stride = game.strides[p];
+        // Lines along axis p start at o * n * stride + inner, for inner < stride
+        for (size_t base = 0; base < game.num_profiles; base += n * stride) {
+            for (size_t inner = 0; inner < stride; inner++) {
+                const double* line = block + base + inner;
+                double best = line[0];
+                for (size_t j = 1; j < n; j++) {
+                    best = max(best, line[j * stride]);
+                }
+                for (size_t j = 0; j < n; j++) {
+                    if (line[j * stride] == best) {
+                        best_count[base + inner + j * stride]++;
+                    }
+                }
+            }
+        }
+    }
+    
+    for (size_t i = 0; i < game.num_profiles; i++) {
+        if (best_count[i] == players) {
+            vector<int> profile(players);
+            for (int p = 0; p < players; p++) {
+                profile[p] = (int)(i / game.strides[p] % game.num_strategies[p]);
+            }
+            equilibria.push_back(profile);
+        }
+    }
+    return equilibria;
+}
+
+bool NPlayerSolver::solveSupports(const vector<vector<int>>& supports, const vector<double>& start,
+                                  vector<vector<double>>& mixes, double tolerance) const {
+    int players = game.numPlayers();
+    vector<int> offset(players + 1, 0);
+    for (int p = 0; p < players; p++) {
+        offset[p + 1] = offset[p] + (int)supports[p].size();
+    }
+    int n = offset[players];
+    
+    // Residuals at x, per player u_p(s_k) - u_p(s_0) for the other support
+    // strategies, then the probabilities summing to one; with a jacobian also
+    // its derivatives. Returns the squared norm of the residuals.
+    vector<double> payoffs, pair;
+    auto evaluate = [&](const vector<double>& x, vector<double>& residual, vector<double>* jacobian) {
+        mixes.assign(players, vector<double>());
+        for (int p = 0; p < players; p++) {
+            mixes[p].assign(game.numStrategies(p), 0.0);
+            for (size_t k = 0; k < supports[p].size(); k++) {
+                mixes[p][supports[p][k]] = x[offset[p] + k];
+            }
+        }
+        residual.assign(n, 0.0);
+        if (jacobian) {
+            jacobian->assign((size_t)n * n, 0.0);
+        }
+        double norm = 0.0;
+        for (int p = 0; p < players; p++) {
+            const vector<int>& own = supports[p];
+            int last = offset[p + 1] - 1;
+            if (own.size() > 1) {
+                deviationPayoffs(mixes, p, payoffs);
+                // Relative to the payoff scale, so the test does not depend on units
+                double scale = 1.0 + abs(payoffs[own[0]]);
+                for (size_t k = 1; k < own.size(); k++) {
+                    double r = payoffs[own[k]] - payoffs[own[0]];
+                    residual[offset[p] + k - 1] = r;
+                    norm += (r / scale) * (r / scale);
+                }
+            }
+            for (int v = offset[p]; v <= last; v++) {
+                residual[last] += x[v];
+            }
+            residual[last] -= 1.0;
+            norm += residual[last] * residual[last];
+            if (!jacobian) {
+                continue;
+            }
+            
+            for (int v = offset[p]; v <= last; v++) {
+                (*jacobian)[(size_t)last * n + v] = 1.0;
+            }
+            if (own.size() == 1) {
+                continue;
+            }
+            // u_p(s) is linear in each other player's mix; its derivatives are
+            // the payoffs of p's strategies against each of q's strategies
+            int np = game.numStrategies(p);
+            for (int q = 0; q < players; q++) {
+                if (q == p) {
+                    continue;
+                }
+                int nq = game.numStrategies(q);
+                contract(p, mixes, (1ULL << p) | (1ULL << q), pair);
+                for (size_t k = 1; k < own.size(); k++) {
+                    double* row = jacobian->data() + (size_t)(offset[p] + k - 1) * n;
+                    for (size_t j = 0; j < supports[q].size(); j++) {
+                        int t = supports[q][j];
+                        double top = p < q ? pair[own[k] * nq + t] : pair[t * np + own[k]];
+                        double base = p < q ? pair[own[0] * nq + t] : pair[t * np + own[0]];
+                        row[offset[q] + j] = top - base;
+                    }
+                }
+            }
+        }
+        return norm;
+    };
+    
+    // Newton's method with backtracking: a step is halved until it reduces
+    // the residual, which keeps starts away from the root from being thrown off
+    vector<double> x = start;
+    vector<double> trial(n), jacobian, residual, step;
+    double norm = evaluate(x, residual, &jacobian);
+    for (int iteration = 0; iteration < 50; iteration++) {
+        if (norm <= 1e-24) {
+            for (double value : x) {
+                if (value < -tolerance) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        
+        step = residual;
+        if (!solveLinearSystem(jacobian, step, n)) {
+            return false;
+        }
+        double scale = 1.0;
+        double trial_norm = norm;
+        for (int halving = 0; halving < 20; halving++, scale *= 0.5) {
+            for (int v = 0; v < n; v++) {
+                trial[v] = x[v] - scale * step[v];
+            }
+            trial_norm = evaluate(trial, residual, nullptr);
+            if (trial_norm < norm) {
+                break;
+            }
+        }
+        if (!(trial_norm < norm)) {
+            return false;
+        }
+        x = trial;
+        norm = evaluate(x, residual, &jacobian);
+    }
+    return false;
+}
+
+vector<NPlayerEquilibrium> NPlayerSolver::supportEnumeration(double tolerance, int newton_starts) const {
+    GAMESOLVER_PHASE(MixedNash);
+    int players = game.numPlayers();
+    vector<NPlayerEquilibrium> equilibria;
+    if (players == 0 || players > 64 || game.num_profiles == 0) {
+        return equilibria;
+    }
+    
+    // Supports of each player as bitmasks, ordered by size
+    vector<vector<uint32_t>> masks(players);
+    int max_total = 0;
+    for (int p = 0; p < players; p++) {
+        if (game.numStrategies(p) > 24) {
+            return equilibria;
+        }
+        for (uint32_t mask = 1; mask < (1u << game.numStrategies(p)); mask++) {
+            masks[p].push_back(mask);
+        }
+        stable_sort(masks[p].begin(), masks[p].end(), [](uint32_t a, uint32_t b) {
+            return __builtin_popcount(a) < __builtin_popcount(b);
+        });
+        max_total += game.numStrategies(p);
+    }
+    
+    // With two players the indifference equations are linear and one start
+    // suffices; otherwise deterministic pseudo-random starts follow the uniform one
+    int num_starts = players > 2 ? max(1, newton_starts) : 1;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    auto nextUnit = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (double)(seed >> 11) / 9007199254740992.0 + 0.05;
+    };
+    
+    vector<vector<int>> supports(players);
+    vector<vector<double>> mixes;
+    vector<size_t> digit(players);
+    for (int total = players; total <= max_total; total++) {
+        fill(digit.begin(), digit.end(), 0);
+        while (true) {
+            int size = 0;
+            for (int p = 0; p < players; p++) {
+                size += __builtin_popcount(masks[p][digit[p]]);
+            }
+            if (size == total) {
+                int unknowns = 0;
+                for (int p = 0; p < players; p++) {
+                    supports[p].clear();
+                    for (int s = 0; s < game.numStrategies(p); s++) {
+                        if (masks[p][digit[p]] & (1u << s)) {
+                            supports[p].push_back(s);
+                        }
+                    }
+                    unknowns += (int)supports[p].size();
+                }
+                
+                // Every player pure: the system is already solved
+                int starts = unknowns == players ? 1 : num_starts;
+                for (int attempt = 0; attempt < starts; attempt++) {
+                    vector<double> start;
+                    start.reserve(unknowns);
+                    for (int p = 0; p < players; p++) {
+                        size_t k = supports[p].size();
+                        vector<double> weights(k, 1.0);
+                        double sum = (double)k;
+                        if (attempt > 0) {
+                            sum = 0.0;
+                            for (double& w : weights) {
+                                w = nextUnit();
+                                sum += w;
+                            }
+                        }
+                        for (double w : weights) {
+                            start.push_back(w / sum);
+                        }
+                    }
+                    if (!solveSupports(supports, start, mixes, tolerance)) {
+                        continue;
+                    }
+                    
+                    for (auto& mix : mixes) {
+                        double sum = 0.0;
+                        for (double& prob : mix) {
+                            prob = max(0.0, prob);
+                            sum += prob;
+                        }
+                        for (double& prob : mix) {
+                            prob /= sum;
+                        }
+                    }
+                    
+                    // No strategy outside the supports may do better
+                    if (!isNashEquilibrium(mixes, 1e-9 + tolerance)) {
+                        continue;
+                    }
+                    
+                    bool duplicate = false;
+                    for (const auto& existing : equilibria) {
+                        bool same = true;
+                        for (int p = 0; p < players && same; p++) {
+                            for (int s = 0; s < game.numStrategies(p); s++) {
+                                if (abs(existing.strategies[p][s] - mixes[p][s]) > 1e-7) {
+                                    same = false;
+                                    break;
+                                }
+                            }
+                        }
+                        if (same) {
+                            duplicate = true;
+                            break;
+                        }
+                    }
+                    if (duplicate) {
+                        continue;
+                    }
+                    
+                    NPlayerEquilibrium eq;
+                    eq.strategies = mixes;
+                    for (int p = 0; p < players; p++) {
+                        eq.payoffs.push_back(expectedPayoff(mixes, p));
+                    }
+                    equilibria.push_back(eq);
+                }
+            }
+            
+            // Next combination of supports, the last player's varying fastest
+            int p = players - 1;
+            while (p >= 0 && ++digit[p] == masks[p].size()) {
+                digit[p] = 0;
+                p--;
+            }
+            if (p < 0) {
+                break;
+            }
+        }
+    }
+    return equilibria;
+}
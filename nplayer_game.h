@@ -0,0 +1,134 @@
+#ifndef NPLAYER_GAME_H
+#define NPLAYER_GAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Normal form game with any number of players. The payoffs form one contiguous
+// tensor [player][s_0][s_1]...[s_{n-1}]: each player's payoffs are a dense
+// row-major block over the pure profiles, with player 0's strategy varying
+// slowest, so contracting a block against mixed strategies streams through it.
+struct NPlayerGame {
+    vector<int> num_strategies; // Strategies of each player
+    vector<size_t> strides;     // Step of each player's strategy axis within a block
+    size_t num_profiles;        // Pure strategy profiles, the size of one block
+    vector<double> payoffs;     // [player][profile]
+    
+    explicit NPlayerGame(const vector<int>& strategies = {}) : num_strategies(strategies), num_profiles(1) {
+        strides.assign(strategies.size(), 1);
+        for (size_t p = strategies.size(); p-- > 0;) {
+            strides[p] = num_profiles;
+            num_profiles *= strategies[p] > 0 ? (size_t)strategies[p] : 0;
+        }
+        payoffs.assign(strategies.size() * num_profiles, 0.0);
+    }
+    
+    int numPlayers() const { return (int)num_strategies.size(); }
+    int numStrategies(int player) const { return num_strategies[player]; }
+    
+    // Index of a pure profile (one strategy per player) within a block
+    size_t profileIndex(const int* profile) const {
+        size_t index = 0;
+        for (size_t p = 0; p < num_strategies.size(); p++) {
+            index += (size_t)profile[p] * strides[p];
+        }
+        return index;
+    }
+    
+    // Whether a profile names a valid strategy for every player
+    bool validProfile(const vector<int>& profile) const {
+        if (profile.size() != num_strategies.size()) {
+            return false;
+        }
+        for (size_t p = 0; p < profile.size(); p++) {
+            if (profile[p] < 0 || profile[p] >= num_strategies[p]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Set payoff for a specific outcome
+    void setPayoff(const vector<int>& profile, int player, double payoff) {
+        if (validProfile(profile) && player >= 0 && player < numPlayers()) {
+            payoffs[player * num_profiles + profileIndex(profile.data())] = payoff;
+        }
+    }
+    
+    // Get payoff for a specific outcome
+    double getPayoff(const vector<int>& profile, int player) const {
+        if (validProfile(profile) && player >= 0 && player < numPlayers()) {
+            return payoffs[player * num_profiles + profileIndex(profile.data())];
+        }
+        return 0.0;
+    }
+    
+    // Get payoff without bounds checking, for solver inner loops
+    double getPayoffUnchecked(size_t profile_index, int player) const {
+        return payoffs[player * num_profiles + profile_index];
+    }
+    
+    // A player's block of payoffs, indexed by profileIndex
+    const double* playerPayoffs(int player) const {
+        return payoffs.data() + player * num_profiles;
+    }
+};
+
+// Mixed strategy Nash equilibrium of an N-player game
+struct NPlayerEquilibrium {
+    vector<vector<double>> strategies; // Probability of each strategy, per player
+    vector<double> payoffs;            // Expected payoff of each player
+};
+
+// Equilibria of N-player games. Expected payoffs are tensor contractions of a
+// player's block against the other players' mixes, one axis at a time, so
+// every inner loop runs over contiguous memory and vectorizes.
+class NPlayerSolver {
+private:
+    const NPlayerGame& game;
+    
+    // Solve the indifference equations of one support profile by Newton's
+    // method from `start`; on success mixes holds the solution
+    bool solveSupports(const vector<vector<int>>& supports, const vector<double>& start,
+                       vector<vector<double>>& mixes, double tolerance) const;
+
+public:
+    explicit NPlayerSolver(const NPlayerGame& g) : game(g) {}
+    
+    // Contract a player's payoffs with mixes[q] along every axis q not in
+    // keep (a bitmask of players). result holds the tensor over the kept axes,
+    // in player order and row-major; with no axis kept it is one value.
+    void contract(int player, const vector<vector<double>>& mixes, uint64_t keep, vector<double>& result) const;
+    
+    // Expected payoff of a player when everyone plays mixes
+    double expectedPayoff(const vector<vector<double>>& mixes, int player) const;
+    
+    // Expected payoff of each of a player's pure strategies against the others' mixes
+    void deviationPayoffs(const vector<vector<double>>& mixes, int player, vector<double>& payoffs) const;
+    
+    // Whether no player gains more than tolerance by a pure deviation
+    bool isNashEquilibrium(const vector<vector<double>>& mixes, double tolerance = 1e-9) const;
+    
+    // Pure equilibria, found by scanning each player's axis for best
+    // responses: a profile is an equilibrium when it is a best response along
+    // every axis. Costs one pass over each player's block.
+    vector<vector<int>> findPureNashEquilibria() const;
+    
+    // Equilibria by support enumeration. For each profile of supports the
+    // indifference conditions form a polynomial system (multilinear in the
+    // other players' probabilities), which is solved by Newton's method from
+    // newton_starts starting points; solutions with negative probabilities or
+    // a profitable deviation outside the supports are dropped. Supports are
+    // tried by increasing total size. With two players the system is linear
+    // and every equilibrium of a nondegenerate game is found; with more, an
+    // equilibrium no start converges to is missed (a generic game has an odd
+    // number of equilibria, so an even count means one was). The number of
+    // support profiles grows as the product of 2^strategies over the players,
+    // so this suits small games.
+    vector<NPlayerEquilibrium> supportEnumeration(double tolerance = 1e-9, int newton_starts = 8) const;
+};
+
+#endif // NPLAYER_GAME_H
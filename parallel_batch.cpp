@@ -0,0 +1,158 @@
+#include "parallel_batch.h"
+#include <algorithm>
+
+using namespace std;
+
+// Create a pool with num_threads workers
+WorkStealingPool::WorkStealingPool(int num_threads)
+    : num_workers(num_threads > 0 ? num_threads : max(1, (int)thread::hardware_concurrency())),
+      ranges(new ChunkRange[num_workers]), generation(0), busy_workers(0), stopping(false),
+      task(nullptr), steals(0) {
+    for (int w = 0; w < num_workers; w++) {
+        ranges[w].next.store(0, memory_order_relaxed);
+        ranges[w].end = 0;
+    }
+    for (int w = 1; w < num_workers; w++) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, w);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> lock(mtx);
+        stopping = true;
+    }
+    start_cv.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+// Body of each background thread
+void WorkStealingPool::workerLoop(int worker) {
+    size_t seen_generation = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(mtx);
+            start_cv.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) {
+                return;
+            }
+            seen_generation = generation;
+        }
+        
+        drain(worker);
+        
+        {
+            lock_guard<mutex> lock(mtx);
+            if (--busy_workers == 0) {
+                done_cv.notify_one();
+            }
+        }
+    }
+}
+
+// Process own chunks, then steal from the other workers
+void WorkStealingPool::drain(int worker) {
+    size_t stolen = 0;
+    for (int k = 0; k < num_workers; k++) {
+        int victim = (worker + k) % num_workers;
+        ChunkRange& range = ranges[victim];
+        while (true) {
+            size_t chunk = range.next.fetch_add(1, memory_order_relaxed);
+            if (chunk >= range.end) {
+                break;
+            }
+            (*task)(chunk, worker);
+            stolen += (victim != worker);
+        }
+    }
+    if (stolen > 0) {
+        steals.fetch_add(stolen, memory_order_relaxed);
+    }
+}
+
+// Run task(chunk, worker) for every chunk and wait for completion
+void WorkStealingPool::run(size_t num_chunks, const function<void(size_t, int)>& job) {
+    {
+        lock_guard<mutex> lock(mtx);
+        size_t per_worker = num_chunks / num_workers;
+        size_t extra = num_chunks % num_workers;
+        size_t begin = 0;
+        for (int w = 0; w < num_workers; w++) {
+            size_t size = per_worker + ((size_t)w < extra ? 1 : 0);
+            ranges[w].next.store(begin, memory_order_relaxed);
+            ranges[w].end = begin + size;
+            begin += size;
+        }
+        task = &job;
+        steals.store(0, memory_order_relaxed);
+        busy_workers = num_workers - 1;
+        generation++;
+    }
+    start_cv.notify_all();
+    
+    drain(0);
+    
+    unique_lock<mutex> lock(mtx);
+    done_cv.wait(lock, [&] { return busy_workers == 0; });
+    task = nullptr;
+}
+
+// Per-worker totals, padded so workers never share a cache line
+struct alignas(64) WorkerTotals {
+    size_t degenerate;
+    size_t with_mixed;
+    size_t chunks;
+};
+
+// Solve a batch on an existing pool
+size_t solveBatch2x2Parallel(const BatchGames2x2& games, const BatchResults2x2& results,
+                             WorkStealingPool& pool, const ParallelBatchOptions& options,
+                             ParallelBatchStats* stats) {
+    size_t chunk_size = max<size_t>(1, options.chunk_size);
+    size_t num_chunks = (games.count + chunk_size - 1) / chunk_size;
+    vector<WorkerTotals> totals(pool.threadCount(), WorkerTotals{0, 0, 0});
+    
+    pool.run(num_chunks, [&](size_t chunk, int worker) {
+        size_t begin = chunk * chunk_size;
+        size_t count = min(chunk_size, games.count - begin);
+        
+        BatchGames2x2 slice = {games.a00 + begin, games.a01 + begin, games.a10 + begin, games.a11 + begin,
+                               games.b00 + begin, games.b01 + begin, games.b10 + begin, games.b11 + begin, count};
+        BatchResults2x2 out = {results.pure_mask + begin, results.num_equilibria + begin, results.flags + begin,
+                               results.mixed_p1 + begin, results.mixed_p2 + begin};
+        WorkerTotals& mine = totals[worker];
+        mine.degenerate += solveBatch2x2(slice, out, options.kernel);
+        mine.chunks++;
+        if (stats) {
+            for (size_t g = 0; g < count; g++) {
+                mine.with_mixed += (out.flags[g] & BATCH_HAS_MIXED) != 0;
+            }
+        }
+    });
+    
+    size_t degenerate = 0;
+    for (const auto& t : totals) {
+        degenerate += t.degenerate;
+    }
+    if (stats) {
+        stats->degenerate = degenerate;
+        stats->with_mixed = 0;
+        stats->chunks = 0;
+        for (const auto& t : totals) {
+            stats->with_mixed += t.with_mixed;
+            stats->chunks += t.chunks;
+        }
+        stats->chunks_stolen = pool.lastStealCount();
+        stats->threads = pool.threadCount();
+    }
+    return degenerate;
+}
+
+// Solve a batch on a temporary pool
+size_t solveBatch2x2Parallel(const BatchGames2x2& games, const BatchResults2x2& results,
+                             const ParallelBatchOptions& options, ParallelBatchStats* stats) {
+    WorkStealingPool pool(options.num_threads);
+    return solveBatch2x2Parallel(games, results, pool, options, stats);
+}
@@ -0,0 +1,98 @@
+#ifndef PARALLEL_BATCH_H
+#define PARALLEL_BATCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "batch_solver.h"
+
+using namespace std;
+
+// Fixed-size thread pool that runs a job made of independent chunks.
+// The chunk range is split into one contiguous slice per worker; a worker
+// drains its own slice first and then steals the remaining chunks of other
+// workers. Claiming a chunk is a single atomic fetch_add, so the hot path
+// takes no locks. The calling thread participates as worker 0.
+class WorkStealingPool {
+private:
+    // Per-worker slice of the chunk range, padded to its own cache line
+    struct alignas(64) ChunkRange {
+        atomic<size_t> next;
+        size_t end;
+    };
+    
+    int num_workers;
+    vector<thread> threads;
+    unique_ptr<ChunkRange[]> ranges;
+    
+    mutex mtx;
+    condition_variable start_cv;
+    condition_variable done_cv;
+    size_t generation;
+    int busy_workers;
+    bool stopping;
+    const function<void(size_t, int)>* task;
+    atomic<size_t> steals;
+    
+    // Body of each background thread
+    void workerLoop(int worker);
+    
+    // Process own chunks, then steal from the other workers
+    void drain(int worker);
+
+public:
+    // Create a pool with num_threads workers (0 = hardware concurrency)
+    explicit WorkStealingPool(int num_threads = 0);
+    ~WorkStealingPool();
+    
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    
+    int threadCount() const { return num_workers; }
+    
+    // Run task(chunk, worker) for every chunk in [0, num_chunks) and wait for completion.
+    // worker is in [0, threadCount()) and identifies the thread running the chunk.
+    void run(size_t num_chunks, const function<void(size_t, int)>& task);
+    
+    // Number of chunks taken from another worker's slice during the last run
+    size_t lastStealCount() const { return steals.load(memory_order_relaxed); }
+};
+
+// Options for the parallel batch driver
+struct ParallelBatchOptions {
+    int num_threads;   // Worker threads, 0 = hardware concurrency
+    size_t chunk_size; // Games per unit of work
+    BatchKernel kernel;
+    
+    ParallelBatchOptions(int threads = 0, size_t chunk = 16384)
+        : num_threads(threads), chunk_size(chunk), kernel(detectBatchKernel()) {}
+};
+
+// Totals gathered from all workers after a parallel solve
+struct ParallelBatchStats {
+    size_t degenerate;    // Games flagged BATCH_DEGENERATE
+    size_t with_mixed;    // Games with a strictly mixed equilibrium
+    size_t chunks;        // Units of work executed
+    size_t chunks_stolen; // Units of work executed by a worker other than their owner
+    int threads;          // Workers used
+    
+    ParallelBatchStats() : degenerate(0), with_mixed(0), chunks(0), chunks_stolen(0), threads(0) {}
+};
+
+// Solve a batch on an existing pool. Each game's results are written to its own
+// index, so the output is identical to solveBatch2x2 whatever the schedule.
+// Returns the number of degenerate games.
+size_t solveBatch2x2Parallel(const BatchGames2x2& games, const BatchResults2x2& results,
+                             WorkStealingPool& pool, const ParallelBatchOptions& options = ParallelBatchOptions(),
+                             ParallelBatchStats* stats = nullptr);
+
+// Solve a batch on a temporary pool of options.num_threads workers
+size_t solveBatch2x2Parallel(const BatchGames2x2& games, const BatchResults2x2& results,
+                             const ParallelBatchOptions& options = ParallelBatchOptions(),
+                             ParallelBatchStats* stats = nullptr);
+
+#endif // PARALLEL_BATCH_H
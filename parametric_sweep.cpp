@@ -0,0 +1,327 @@
+#include "parametric_sweep.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// c0 + c1 * t
+struct AffineTerm {
+    double c0;
+    double c1;
+};
+
+// c0 + c1 * t + c2 * t^2
+struct QuadraticTerm {
+    double c0;
+    double c1;
+    double c2;
+};
+
+static AffineTerm operator-(const AffineTerm& a, const AffineTerm& b) {
+    return {a.c0 - b.c0, a.c1 - b.c1};
+}
+
+static AffineTerm operator+(const AffineTerm& a, const AffineTerm& b) {
+    return {a.c0 + b.c0, a.c1 + b.c1};
+}
+
+static QuadraticTerm operator*(const AffineTerm& a, const AffineTerm& b) {
+    return {a.c0 * b.c0, a.c0 * b.c1 + a.c1 * b.c0, a.c1 * b.c1};
+}
+
+static QuadraticTerm operator-(const QuadraticTerm& a, const QuadraticTerm& b) {
+    return {a.c0 - b.c0, a.c1 - b.c1, a.c2 - b.c2};
+}
+
+// Real roots of a polynomial of degree at most two; none if it is identically zero
+static void appendRoots(const QuadraticTerm& f, vector<double>& roots) {
+    if (f.c2 == 0.0) {
+        if (f.c1 != 0.0) {
+            roots.push_back(-f.c0 / f.c1);
+        }
+        return;
+    }
+    double discriminant = f.c1 * f.c1 - 4.0 * f.c2 * f.c0;
+    if (discriminant < 0.0) {
+        return;
+    }
+    // Numerically stable form: never subtract nearly equal numbers
+    double q = -0.5 * (f.c1 + copysign(sqrt(discriminant), f.c1));
+    roots.push_back(q / f.c2);
+    if (q != 0.0) {
+        roots.push_back(f.c0 / q);
+    }
+}
+
+static void appendRoots(const AffineTerm& f, vector<double>& roots) {
+    appendRoots(QuadraticTerm{f.c0, f.c1, 0.0}, roots);
+}
+
+// Payoff of a player at (row, col) as an affine function of t, with s fixed
+static AffineTerm payoffTerm(const AffineGame2x2& game, int row, int col, int player, double s) {
+    return {game.base.getPayoffUnchecked(row, col, player) + s * game.ds.getPayoffUnchecked(row, col, player),
+            game.dt.getPayoffUnchecked(row, col, player)};
+}
+
+// Roots of every quantity whose sign the analytic solver tests, for the
+// leader `player` and the opponent's best response (intercept + slope * x)
+static void appendCriticalRoots(const AffineTerm payoffs[2][2], const AffineTerm& opponent_intercept,
+                                const AffineTerm& opponent_slope, int player, vector<double>& roots) {
+    // Own payoffs against each other: pure equilibria, best response gains and
+    // the anticipated payoffs at the ends of the unit interval
+    const AffineTerm values[4] = {payoffs[0][0], payoffs[0][1], payoffs[1][0], payoffs[1][1]};
+    for (int a = 0; a < 4; a++) {
+        for (int b = a + 1; b < 4; b++) {
+            appendRoots(values[a] - values[b], roots);
+        }
+    }
+    
+    // The opponent's indifference point: whether it exists and lies in [0, 1]
+    appendRoots(opponent_intercept, roots);
+    appendRoots(opponent_slope, roots);
+    appendRoots(opponent_intercept + opponent_slope, roots);
+    
+    // Anticipated payoff at the opponent's indifference point r = -intercept / slope,
+    // on either side of it, against the end values and each other (times slope)
+    AffineTerm if_strategy1[2];
+    AffineTerm if_strategy2[2];
+    for (int response = 0; response < 2; response++) {
+        // Player 1's payoffs from rows 1/2 against column `response`, or player 2's from columns 1/2 against row `response`
+        if_strategy1[response] = (player == 0) ? payoffs[0][response] : payoffs[response][0];
+        if_strategy2[response] = (player == 0) ? payoffs[1][response] : payoffs[response][1];
+    }
+    QuadraticTerm scaled_value[2];
+    for (int response = 0; response < 2; response++) {
+        AffineTerm gain = if_strategy1[response] - if_strategy2[response];
+        scaled_value[response] = if_strategy2[response] * opponent_slope - gain * opponent_intercept;
+        for (const AffineTerm& value : values) {
+            appendRoots(scaled_value[response] - value * opponent_slope, roots);
+        }
+    }
+    appendRoots(scaled_value[0] - scaled_value[1], roots);
+}
+
+// Indifference point of a player's best response as a function of t
+static ParametricProbability indifferencePoint(const BestResponseCache& at_zero, const BestResponseCache& per_unit) {
+    return {-at_zero.gain_intercept, -per_unit.gain_intercept, at_zero.gain_slope, per_unit.gain_slope};
+}
+
+// Express equilibria found at one parameter value in closed form: each
+// coordinate is 0, 1 or the indifference point of the other player
+static vector<ParametricEquilibrium> parametrize(const vector<Equilibrium>& equilibria,
+                                                 const ParametricProbability& p1_root,
+                                                 const ParametricProbability& p2_root) {
+    auto form = [](double value, const ParametricProbability& root) {
+        return (value == 0.0 || value == 1.0) ? ParametricProbability::constant(value) : root;
+    };
+    
+    vector<ParametricEquilibrium> result;
+    result.reserve(equilibria.size());
+    for (const auto& eq : equilibria) {
+        result.push_back({form(eq.profile.p1_strategy1_prob, p1_root), form(eq.profile.p2_strategy1_prob, p2_root),
+                          form(eq.profile_end.p1_strategy1_prob, p1_root),
+                          form(eq.profile_end.p2_strategy1_prob, p2_root), eq.kind, eq.isContinuum});
+    }
+    return result;
+}
+
+// Equilibria found at one parameter value, as constants
+static vector<ParametricEquilibrium> freeze(const vector<Equilibrium>& equilibria) {
+    vector<ParametricEquilibrium> result;
+    result.reserve(equilibria.size());
+    for (const auto& eq : equilibria) {
+        result.push_back({ParametricProbability::constant(eq.profile.p1_strategy1_prob),
+                          ParametricProbability::constant(eq.profile.p2_strategy1_prob),
+                          ParametricProbability::constant(eq.profile_end.p1_strategy1_prob),
+                          ParametricProbability::constant(eq.profile_end.p2_strategy1_prob), eq.kind, eq.isContinuum});
+    }
+    return result;
+}
+
+// Whether the equilibria of a breakpoint are those of an interval evaluated at the breakpoint
+static bool sameAt(const vector<ParametricEquilibrium>& point, const vector<ParametricEquilibrium>& interval, double t) {
+    if (point.size() != interval.size()) {
+        return false;
+    }
+    const double tolerance = 1e-9;
+    for (size_t i = 0; i < point.size(); i++) {
+        Equilibrium a = point[i].at(t);
+        Equilibrium b = interval[i].at(t);
+        if (a.kind != b.kind || a.isContinuum != b.isContinuum ||
+            abs(a.profile.p1_strategy1_prob - b.profile.p1_strategy1_prob) > tolerance ||
+            abs(a.profile.p2_strategy1_prob - b.profile.p2_strategy1_prob) > tolerance ||
+            abs(a.profile_end.p1_strategy1_prob - b.profile_end.p1_strategy1_prob) > tolerance ||
+            abs(a.profile_end.p2_strategy1_prob - b.profile_end.p2_strategy1_prob) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Point of the open interval (lo, hi) with the shortest binary expansion,
+// preferring integers. Ties that hold on a whole interval then tend to come
+// out exact, as they do for the payoffs users type in.
+static double representativePoint(double lo, double hi) {
+    double mid = 0.5 * (lo + hi);
+    for (int bits = 0; bits < 64; bits++) {
+        double scale = ldexp(1.0, bits);
+        double candidate = round(mid * scale) / scale;
+        if (candidate > lo && candidate < hi) {
+            return candidate;
+        }
+    }
+    return mid;
+}
+
+ParametricSweep sweepEquilibria(const AffineGame2x2& game, double t_min, double t_max, double s) {
+    ParametricSweep sweep;
+    sweep.t_min = t_min;
+    sweep.t_max = t_max;
+    sweep.s = s;
+    
+    // Candidate breakpoints: roots of every sign test of the analytic solver
+    AffineTerm payoffs[2][2][2];
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            for (int k = 0; k < 2; k++) {
+                payoffs[k][i][j] = payoffTerm(game, i, j, k, s);
+            }
+        }
+    }
+    // Best response gains are linear in the payoffs, so their coefficients
+    // are the gains of the game at t = 0 and of the per-unit change dt
+    NormalFormSolver at_zero(game.at(0.0, s));
+    NormalFormSolver per_unit(game.dt);
+    AffineTerm intercept[2];
+    AffineTerm slope[2];
+    for (int k = 0; k < 2; k++) {
+        const BestResponseCache& c0 = at_zero.getBestResponseCache(k);
+        const BestResponseCache& c1 = per_unit.getBestResponseCache(k);
+        intercept[k] = {c0.gain_intercept, c1.gain_intercept};
+        slope[k] = {c0.gain_slope, c1.gain_slope};
+    }
+    vector<double> roots;
+    appendCriticalRoots(payoffs[0], intercept[1], slope[1], 0, roots);
+    appendCriticalRoots(payoffs[1], intercept[0], slope[0], 1, roots);
+    
+    // Keep the distinct roots in range; those at the ends make the ends breakpoints
+    auto close = [](double a, double b) { return abs(a - b) <= 1e-12 * max(1.0, max(abs(a), abs(b))); };
+    sort(roots.begin(), roots.end());
+    vector<double> cuts;
+    bool min_is_breakpoint = false;
+    bool max_is_breakpoint = false;
+    for (double r : roots) {
+        if (!isfinite(r)) {
+            continue;
+        }
+        if (close(r, t_min)) {
+            min_is_breakpoint = true;
+        } else if (close(r, t_max)) {
+            max_is_breakpoint = true;
+        } else if (r > t_min && r < t_max && (cuts.empty() || !close(cuts.back(), r))) {
+            cuts.push_back(r);
+        }
+    }
+    
+    ParametricProbability p1_root = indifferencePoint(at_zero.getBestResponseCache(1), per_unit.getBestResponseCache(1));
+    ParametricProbability p2_root = indifferencePoint(at_zero.getBestResponseCache(0), per_unit.getBestResponseCache(0));
+    
+    auto pointRegime = [&](double t) {
+        NormalFormSolver solver(game.at(t, s));
+        return SweepRegime{t, t, freeze(solver.findAllNashEquilibria()), freeze(solver.findNonMyopicEquilibria())};
+    };
+    auto intervalRegime = [&](double lo, double hi) {
+        NormalFormSolver solver(game.at(representativePoint(lo, hi), s));
+        return SweepRegime{lo, hi, parametrize(solver.findAllNashEquilibria(), p1_root, p2_root),
+                           parametrize(solver.findNonMyopicEquilibria(), p1_root, p2_root)};
+    };
+    
+    if (!(t_min < t_max)) {
+        sweep.regimes.push_back(pointRegime(t_min));
+        sweep.breakpoints.push_back(t_min);
+        return sweep;
+    }
+    
+    // Alternate intervals and breakpoints
+    vector<SweepRegime> regimes;
+    if (min_is_breakpoint) {
+        regimes.push_back(pointRegime(t_min));
+    }
+    double lo = t_min;
+    for (double cut : cuts) {
+        regimes.push_back(intervalRegime(lo, cut));
+        regimes.push_back(pointRegime(cut));
+        lo = cut;
+    }
+    regimes.push_back(intervalRegime(lo, t_max));
+    if (max_is_breakpoint) {
+        regimes.push_back(pointRegime(t_max));
+    }
+    
+    // Drop candidate breakpoints where nothing changes
+    for (size_t i = 0; i < regimes.size(); i++) {
+        if (regimes[i].isBreakpoint() && !sweep.regimes.empty() && !sweep.regimes.back().isBreakpoint() &&
+            i + 1 < regimes.size() && !regimes[i + 1].isBreakpoint()) {
+            SweepRegime& before = sweep.regimes.back();
+            const SweepRegime& point = regimes[i];
+            const SweepRegime& after = regimes[i + 1];
+            if (before.nash_equilibria == after.nash_equilibria &&
+                before.non_myopic_equilibria == after.non_myopic_equilibria &&
+                sameAt(point.nash_equilibria, before.nash_equilibria, point.t_lo) &&
+                sameAt(point.non_myopic_equilibria, before.non_myopic_equilibria, point.t_lo)) {
+                before.t_hi = after.t_hi;
+                i++;
+                continue;
+            }
+        }
+        sweep.regimes.push_back(regimes[i]);
+    }
+    for (const auto& regime : sweep.regimes) {
+        if (regime.isBreakpoint()) {
+            sweep.breakpoints.push_back(regime.t_lo);
+        }
+    }
+    
+    return sweep;
+}
+
+const SweepRegime& ParametricSweep::regimeAt(double t) const {
+    // First regime ending at or after t; an interval ending exactly at t is followed by the breakpoint t
+    auto it = lower_bound(regimes.begin(), regimes.end(), t,
+                          [](const SweepRegime& regime, double value) { return regime.t_hi < value; });
+    if (it == regimes.end()) {
+        return regimes.back();
+    }
+    if (!it->isBreakpoint() && it->t_hi == t && it + 1 != regimes.end()) {
+        ++it;
+    }
+    return *it;
+}
+
+static vector<Equilibrium> evaluate(const vector<ParametricEquilibrium>& equilibria, double t) {
+    vector<Equilibrium> result;
+    result.reserve(equilibria.size());
+    for (const auto& eq : equilibria) {
+        result.push_back(eq.at(t));
+    }
+    return result;
+}
+
+vector<Equilibrium> ParametricSweep::nashEquilibriaAt(double t) const {
+    return evaluate(regimeAt(t).nash_equilibria, t);
+}
+
+vector<Equilibrium> ParametricSweep::nonMyopicEquilibriaAt(double t) const {
+    return evaluate(regimeAt(t).non_myopic_equilibria, t);
+}
+
+vector<ParametricSweep> sweepEquilibria2D(const AffineGame2x2& game, double t_min, double t_max,
+                                          double s_min, double s_max, int s_steps) {
+    vector<ParametricSweep> sweeps;
+    sweeps.reserve(max(s_steps, 0));
+    for (int i = 0; i < s_steps; i++) {
+        double s = (s_steps == 1) ? s_min : s_min + (s_max - s_min) * i / (s_steps - 1);
+        sweeps.push_back(sweepEquilibria(game, t_min, t_max, s));
+    }
+    return sweeps;
+}
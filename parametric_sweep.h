@@ -0,0 +1,133 @@
+#ifndef PARAMETRIC_SWEEP_H
+#define PARAMETRIC_SWEEP_H
+
+#include <vector>
+#include "game_solver.h"
+
+using namespace std;
+
+// 2x2 game whose payoffs depend affinely on up to two parameters:
+// payoff(t, s) = base + t * dt + s * ds, cell by cell
+struct AffineGame2x2 {
+    Game2x2 base;
+    Game2x2 dt; // Change of each payoff per unit of t
+    Game2x2 ds; // Change of each payoff per unit of s (all zero for one parameter)
+    
+    AffineGame2x2() {}
+    AffineGame2x2(const Game2x2& b, const Game2x2& t_slope) : base(b), dt(t_slope) {}
+    AffineGame2x2(const Game2x2& b, const Game2x2& t_slope, const Game2x2& s_slope)
+        : base(b), dt(t_slope), ds(s_slope) {}
+    
+    // The game at one parameter value
+    Game2x2 at(double t, double s = 0.0) const {
+        Game2x2 game;
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2; j++) {
+                for (int k = 0; k < 2; k++) {
+                    game.setPayoff(i, j, k, base.getPayoffUnchecked(i, j, k) + t * dt.getPayoffUnchecked(i, j, k) +
+                                            s * ds.getPayoffUnchecked(i, j, k));
+                }
+            }
+        }
+        return game;
+    }
+};
+
+// Probability as a function of t: (num0 + num1 * t) / (den0 + den1 * t).
+// Within a regime every equilibrium coordinate is either a constant or the
+// indifference point of the other player's best response, which has this form.
+struct ParametricProbability {
+    double num0;
+    double num1;
+    double den0;
+    double den1;
+    
+    static ParametricProbability constant(double value) {
+        return {value, 0.0, 1.0, 0.0};
+    }
+    
+    double operator()(double t) const {
+        double value = (num0 + num1 * t) / (den0 + den1 * t);
+        return value == 0.0 ? 0.0 : value;
+    }
+    
+    bool isConstant() const {
+        return num1 == 0.0 && den1 == 0.0;
+    }
+    
+    bool operator==(const ParametricProbability& other) const {
+        return num0 == other.num0 && num1 == other.num1 && den0 == other.den0 && den1 == other.den1;
+    }
+};
+
+// Equilibrium whose profile (or box corners, for a continuum) are functions of t
+struct ParametricEquilibrium {
+    ParametricProbability p1_lo;
+    ParametricProbability p2_lo;
+    ParametricProbability p1_hi;
+    ParametricProbability p2_hi;
+    EquilibriumKind kind;
+    bool isContinuum;
+    
+    // The equilibrium record at one parameter value
+    Equilibrium at(double t) const {
+        StrategyProfile lo(p1_lo(t), p2_lo(t));
+        if (!isContinuum) {
+            return Equilibrium(lo, kind);
+        }
+        return Equilibrium(lo, StrategyProfile(p1_hi(t), p2_hi(t)), kind);
+    }
+    
+    bool operator==(const ParametricEquilibrium& other) const {
+        return kind == other.kind && isContinuum == other.isContinuum && p1_lo == other.p1_lo &&
+               p2_lo == other.p2_lo && p1_hi == other.p1_hi && p2_hi == other.p2_hi;
+    }
+};
+
+// Parameter range with a fixed equilibrium structure: the open interval
+// (t_lo, t_hi), or the single breakpoint t_lo when t_lo == t_hi. An interval
+// also covers a sweep end that is not a breakpoint.
+struct SweepRegime {
+    double t_lo;
+    double t_hi;
+    vector<ParametricEquilibrium> nash_equilibria;
+    vector<ParametricEquilibrium> non_myopic_equilibria;
+    
+    bool isBreakpoint() const {
+        return t_lo == t_hi;
+    }
+};
+
+// Equilibria of an AffineGame2x2 over a range of t, as found by the analytic solver
+struct ParametricSweep {
+    double t_min;
+    double t_max;
+    double s;                    // Value of the second parameter
+    vector<double> breakpoints;  // Parameter values where the equilibrium structure changes, ascending
+    vector<SweepRegime> regimes; // In ascending order, covering [t_min, t_max]
+    
+    // Regime containing t, which must lie in [t_min, t_max]
+    const SweepRegime& regimeAt(double t) const;
+    
+    // Nash / non-myopic equilibria at t, in NormalFormSolver's format. Where
+    // candidates tie exactly over a whole regime, every tied equilibrium is
+    // kept. A direct solve of the game at t compares rounded payoffs and may
+    // break such a tie, so it can report fewer equilibria there.
+    vector<Equilibrium> nashEquilibriaAt(double t) const;
+    vector<Equilibrium> nonMyopicEquilibriaAt(double t) const;
+};
+
+// Sweep t over [t_min, t_max] with the second parameter fixed at s.
+// Every sign test made by the analytic solver compares payoffs, indifference
+// points and anticipated payoffs, which are polynomials of degree at most two
+// in t; their roots are the only candidate breakpoints. The game is solved once
+// per regime and the equilibria are expressed in closed form, so the cost grows
+// with the number of regime changes and not with how finely t is sampled.
+ParametricSweep sweepEquilibria(const AffineGame2x2& game, double t_min, double t_max, double s = 0.0);
+
+// Two-parameter sweep: one sweep over t for each of s_steps values of s evenly
+// spaced over [s_min, s_max] (a single sweep at s_min if s_steps is 1)
+vector<ParametricSweep> sweepEquilibria2D(const AffineGame2x2& game, double t_min, double t_max,
+                                          double s_min, double s_max, int s_steps);
+
+#endif // PARAMETRIC_SWEEP_H
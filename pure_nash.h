@@ -0,0 +1,151 @@
+#ifndef PURE_NASH_H
+#define PURE_NASH_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "bimatrix_game.h"
+#include "dominance.h"
+
+using namespace std;
+
+// Independent lanes of the row reductions in pureNashMasks. Floating point
+// reductions do not vectorize, but an elementwise update of a few lanes does.
+const int kPureNashLanes = 8;
+
+// One row of pureNashMasks: update player 1's running column maxima and,
+// in kPureNashLanes lanes, player 2's running maximum over the row with the
+// number of columns attaining it and the sum of their indices. Branch free: a
+// new maximum restarts a lane's count and index sum, an equal payoff adds to
+// them. The counts and sums are small integers, exact in double, and blending
+// by multiplication vectorizes even without SSE4.1 blends. The arrays are
+// __restrict parameters so the lane updates vectorize without alias checks.
+template<class GameT>
+inline void pureNashRow(const GameT& game, int row, double* __restrict col_max, double* __restrict lane_max,
+                        double* __restrict lane_ties, double* __restrict lane_arg, double* __restrict lane_index) {
+    int cols = game.cols();
+    for (int k = 0; k < kPureNashLanes; k++) {
+        lane_max[k] = -INFINITY;
+        lane_ties[k] = 0.0;
+        lane_arg[k] = 0.0;
+        lane_index[k] = k;
+    }
+    
+    int j = 0;
+    for (; j + kPureNashLanes <= cols; j += kPureNashLanes) {
+        for (int k = 0; k < kPureNashLanes; k++) {
+            double first = game.getPayoffUnchecked(row, j + k, 0);
+            double second = game.getPayoffUnchecked(row, j + k, 1);
+            double index = lane_index[k];
+            double above = second > lane_max[k] ? 1.0 : 0.0;
+            double equal = second == lane_max[k] ? 1.0 : 0.0;
+            col_max[j + k] = first > col_max[j + k] ? first : col_max[j + k];
+            lane_ties[k] = above + (1.0 - above) * (lane_ties[k] + equal);
+            lane_arg[k] = above * index + (1.0 - above) * (lane_arg[k] + equal * index);
+            lane_max[k] = second > lane_max[k] ? second : lane_max[k];
+            lane_index[k] = index + kPureNashLanes;
+        }
+    }
+    for (; j < cols; j++) {
+        double first = game.getPayoffUnchecked(row, j, 0);
+        double second = game.getPayoffUnchecked(row, j, 1);
+        double above = second > lane_max[0] ? 1.0 : 0.0;
+        double equal = second == lane_max[0] ? 1.0 : 0.0;
+        col_max[j] = first > col_max[j] ? first : col_max[j];
+        lane_ties[0] = above + (1.0 - above) * (lane_ties[0] + equal);
+        lane_arg[0] = above * j + (1.0 - above) * (lane_arg[0] + equal * j);
+        lane_max[0] = second > lane_max[0] ? second : lane_max[0];
+    }
+}
+
+// Pure Nash equilibria of a large bimatrix game in a single streaming pass
+// over the payoffs. Each row is read once, in storage order, by one loop that
+// updates player 1's running column maxima and, in kPureNashLanes lanes,
+// player 2's running maximum over the row with the number of columns
+// attaining it and the sum of their indices. Player 2's best responses to the
+// row are marked in a bitset of columns, and player 1's payoffs in the marked
+// cells are recorded while the row is still in cache. Once every row has been
+// read the column maxima are final, and each row's bitset is ANDed with
+// player 1's best responses by comparing the recorded payoffs, usually one per
+// row, without reading the game again. The result is one StrategyMask of
+// equilibrium columns per row.
+template<class GameT>
+vector<StrategyMask> pureNashMasks(const GameT& game) {
+    int rows = game.rows();
+    int cols = game.cols();
+    vector<StrategyMask> masks(rows, StrategyMask(cols));
+    if (rows == 0 || cols == 0) {
+        return masks;
+    }
+    
+    vector<double> col_max(cols, -INFINITY);
+    vector<double> marked_payoffs; // Player 1's payoff in each marked cell, in row-major order
+    marked_payoffs.reserve(rows);
+    
+    // The lanes live in memory so that their update vectorizes as a loop
+    vector<double> lanes(4 * kPureNashLanes);
+    double* lane_max = lanes.data();
+    double* lane_ties = lane_max + kPureNashLanes;
+    double* lane_arg = lane_ties + kPureNashLanes;
+    double* lane_index = lane_arg + kPureNashLanes;
+    for (int i = 0; i < rows; i++) {
+        pureNashRow(game, i, col_max.data(), lane_max, lane_ties, lane_arg, lane_index);
+        
+        // Combine the lanes; with a single best response the sum is its index
+        double row_max = *max_element(lane_max, lane_max + kPureNashLanes);
+        int64_t ties = 0;
+        int64_t arg = 0;
+        for (int k = 0; k < kPureNashLanes; k++) {
+            if (lane_max[k] == row_max) {
+                ties += (int64_t)lane_ties[k];
+                arg += (int64_t)lane_arg[k];
+            }
+        }
+        
+        // Otherwise mark every tie
+        StrategyMask& mask = masks[i];
+        if (ties == 1) {
+            mask.set((int)arg);
+            marked_payoffs.push_back(game.getPayoffUnchecked(i, (int)arg, 0));
+        } else {
+            for (int k = 0; k < cols; k++) {
+                if (game.getPayoffUnchecked(i, k, 1) >= row_max) {
+                    mask.set(k);
+                    marked_payoffs.push_back(game.getPayoffUnchecked(i, k, 0));
+                }
+            }
+        }
+    }
+    
+    const double* marked = marked_payoffs.data();
+    for (int i = 0; i < rows; i++) {
+        StrategyMask& mask = masks[i];
+        for (size_t w = 0; w < mask.numWords(); w++) {
+            for (uint64_t bits = mask.word(w); bits; bits &= bits - 1) {
+                int j = (int)(w * 64) + __builtin_ctzll(bits);
+                if (*marked++ < col_max[j]) {
+                    mask.reset(j);
+                }
+            }
+        }
+    }
+    return masks;
+}
+
+// Pure Nash equilibria in row-major order, the same list as
+// BimatrixSolver::findPureNashEquilibria, read from pureNashMasks
+template<class GameT>
+vector<PureProfile> screenPureNashEquilibria(const GameT& game) {
+    vector<StrategyMask> masks = pureNashMasks(game);
+    vector<PureProfile> equilibria;
+    for (int i = 0; i < (int)masks.size(); i++) {
+        for (size_t w = 0; w < masks[i].numWords(); w++) {
+            for (uint64_t bits = masks[i].word(w); bits; bits &= bits - 1) {
+                equilibria.emplace_back(i, (int)(w * 64) + __builtin_ctzll(bits));
+            }
+        }
+    }
+    return equilibria;
+}
+
+#endif // PURE_NASH_H
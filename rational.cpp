@@ -0,0 +1,427 @@
+#include "rational.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using namespace std;
+
+BigInt::BigInt(__int128 value) : negative(value < 0) {
+    unsigned __int128 magnitude = negative ? -(unsigned __int128)value : (unsigned __int128)value;
+    while (magnitude) {
+        limbs.push_back((uint32_t)magnitude);
+        magnitude >>= 32;
+    }
+}
+
+void BigInt::trim() {
+    while (!limbs.empty() && limbs.back() == 0) {
+        limbs.pop_back();
+    }
+    if (limbs.empty()) {
+        negative = false;
+    }
+}
+
+int BigInt::compareMagnitude(const BigInt& a, const BigInt& b) {
+    if (a.limbs.size() != b.limbs.size()) {
+        return a.limbs.size() < b.limbs.size() ? -1 : 1;
+    }
+    for (size_t i = a.limbs.size(); i-- > 0;) {
+        if (a.limbs[i] != b.limbs[i]) {
+            return a.limbs[i] < b.limbs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+void BigInt::addMagnitude(BigInt& a, const BigInt& b) {
+    if (a.limbs.size() < b.limbs.size()) {
+        a.limbs.resize(b.limbs.size(), 0);
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < a.limbs.size(); i++) {
+        uint64_t sum = (uint64_t)a.limbs[i] + (i < b.limbs.size() ? b.limbs[i] : 0) + carry;
+        a.limbs[i] = (uint32_t)sum;
+        carry = sum >> 32;
+    }
+    if (carry) {
+        a.limbs.push_back((uint32_t)carry);
+    }
+}
+
+void BigInt::subtractMagnitude(BigInt& a, const BigInt& b) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < a.limbs.size(); i++) {
+        int64_t diff = (int64_t)a.limbs[i] - (i < b.limbs.size() ? b.limbs[i] : 0) - borrow;
+        borrow = diff < 0;
+        a.limbs[i] = (uint32_t)(diff + (borrow << 32));
+    }
+    a.trim();
+}
+
+BigInt BigInt::abs() const {
+    BigInt result = *this;
+    result.negative = false;
+    return result;
+}
+
+int BigInt::bitLength() const {
+    if (limbs.empty()) {
+        return 0;
+    }
+    return (int)(limbs.size() - 1) * 32 + (32 - __builtin_clz(limbs.back()));
+}
+
+bool BigInt::toInt128(__int128& value) const {
+    if (bitLength() > 126) {
+        return false;
+    }
+    unsigned __int128 magnitude = 0;
+    for (size_t i = limbs.size(); i-- > 0;) {
+        magnitude = (magnitude << 32) | limbs[i];
+    }
+    value = negative ? -(__int128)magnitude : (__int128)magnitude;
+    return true;
+}
+
+double BigInt::scaled(int& exponent) const {
+    int bits = bitLength();
+    exponent = max(0, bits - 64);
+    uint64_t top = 0;
+    bool sticky = false;
+    for (int b = bits - 1; b >= 0; b--) {
+        bool bit = (limbs[b >> 5] >> (b & 31)) & 1;
+        if (b >= exponent) {
+            top = (top << 1) | bit;
+        } else if (bit) {
+            // Keep the dropped bits from rounding like an exact tie
+            sticky = true;
+            break;
+        }
+    }
+    if (sticky) {
+        top |= 1;
+    }
+    double result = (double)top;
+    return negative ? -result : result;
+}
+
+double BigInt::toDouble() const {
+    int exponent;
+    double mantissa = scaled(exponent);
+    return ldexp(mantissa, exponent);
+}
+
+string BigInt::toString() const {
+    if (limbs.empty()) {
+        return "0";
+    }
+    // Peel off nine decimal digits at a time
+    vector<uint32_t> magnitude = limbs;
+    string digits;
+    while (!magnitude.empty()) {
+        uint64_t remainder = 0;
+        for (size_t i = magnitude.size(); i-- > 0;) {
+            uint64_t current = (remainder << 32) | magnitude[i];
+            magnitude[i] = (uint32_t)(current / 1000000000);
+            remainder = current % 1000000000;
+        }
+        while (!magnitude.empty() && magnitude.back() == 0) {
+            magnitude.pop_back();
+        }
+        for (int d = 0; d < 9 && (remainder || !magnitude.empty()); d++) {
+            digits.push_back((char)('0' + remainder % 10));
+            remainder /= 10;
+        }
+    }
+    if (negative) {
+        digits.push_back('-');
+    }
+    reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+BigInt& BigInt::operator+=(const BigInt& other) {
+    if (negative == other.negative) {
+        addMagnitude(*this, other);
+    } else if (compareMagnitude(*this, other) >= 0) {
+        subtractMagnitude(*this, other);
+    } else {
+        BigInt result = other;
+        subtractMagnitude(result, *this);
+        *this = result;
+    }
+    trim();
+    return *this;
+}
+
+BigInt& BigInt::operator-=(const BigInt& other) {
+    return *this += -other;
+}
+
+BigInt& BigInt::operator<<=(int bits) {
+    if (limbs.empty() || bits <= 0) {
+        return *this;
+    }
+    int whole = bits / 32;
+    int part = bits % 32;
+    limbs.insert(limbs.begin(), whole, 0);
+    if (part) {
+        uint32_t carry = 0;
+        for (size_t i = whole; i < limbs.size(); i++) {
+            uint32_t next = limbs[i] >> (32 - part);
+            limbs[i] = (limbs[i] << part) | carry;
+            carry = next;
+        }
+        if (carry) {
+            limbs.push_back(carry);
+        }
+    }
+    return *this;
+}
+
+int BigInt::trailingZeros() const {
+    for (size_t i = 0; i < limbs.size(); i++) {
+        if (limbs[i]) {
+            return (int)i * 32 + __builtin_ctz(limbs[i]);
+        }
+    }
+    return 0;
+}
+
+BigInt& BigInt::operator>>=(int bits) {
+    int whole = bits / 32;
+    int part = bits % 32;
+    if (bits <= 0) {
+        return *this;
+    }
+    if ((size_t)whole >= limbs.size()) {
+        limbs.clear();
+        negative = false;
+        return *this;
+    }
+    limbs.erase(limbs.begin(), limbs.begin() + whole);
+    if (part) {
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint32_t next = i + 1 < limbs.size() ? limbs[i + 1] : 0;
+            limbs[i] = (limbs[i] >> part) | (next << (32 - part));
+        }
+    }
+    trim();
+    return *this;
+}
+
+BigInt operator*(const BigInt& a, const BigInt& b) {
+    BigInt result;
+    if (a.isZero() || b.isZero()) {
+        return result;
+    }
+    result.limbs.assign(a.limbs.size() + b.limbs.size(), 0);
+    for (size_t i = 0; i < a.limbs.size(); i++) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < b.limbs.size(); j++) {
+            uint64_t current = (uint64_t)a.limbs[i] * b.limbs[j] + result.limbs[i + j] + carry;
+            result.limbs[i + j] = (uint32_t)current;
+            carry = current >> 32;
+        }
+        result.limbs[i + b.limbs.size()] = (uint32_t)carry;
+    }
+    result.negative = a.negative != b.negative;
+    result.trim();
+    return result;
+}
+
+// Binary long division of the magnitudes, one bit of the quotient at a time
+void BigInt::divide(BigInt a, BigInt b, BigInt& quotient, BigInt& remainder) {
+    BigInt divisor = b.abs();
+    quotient = BigInt();
+    remainder = BigInt();
+    quotient.limbs.assign(a.limbs.size(), 0);
+    for (int bit = a.bitLength() - 1; bit >= 0; bit--) {
+        remainder <<= 1;
+        if ((a.limbs[bit >> 5] >> (bit & 31)) & 1) {
+            if (remainder.limbs.empty()) {
+                remainder.limbs.push_back(0);
+            }
+            remainder.limbs[0] |= 1;
+        }
+        if (compareMagnitude(remainder, divisor) >= 0) {
+            subtractMagnitude(remainder, divisor);
+            quotient.limbs[bit >> 5] |= 1u << (bit & 31);
+        }
+    }
+    quotient.negative = a.negative != b.negative;
+    quotient.trim();
+    remainder.negative = a.negative;
+    remainder.trim();
+}
+
+BigInt BigInt::gcd(BigInt a, BigInt b) {
+    a = a.abs();
+    b = b.abs();
+    while (!b.isZero()) {
+        BigInt quotient, remainder;
+        divide(a, b, quotient, remainder);
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
+
+int compare(const BigInt& a, const BigInt& b) {
+    if (a.sign() != b.sign()) {
+        return a.sign() < b.sign() ? -1 : 1;
+    }
+    int magnitude = BigInt::compareMagnitude(a, b);
+    return a.negative ? -magnitude : magnitude;
+}
+
+static int trailingZeros(unsigned __int128 x) {
+    uint64_t low = (uint64_t)x;
+    return low ? __builtin_ctzll(low) : 64 + __builtin_ctzll((uint64_t)(x >> 64));
+}
+
+// Binary gcd of two non-zero magnitudes
+static unsigned __int128 gcd128(unsigned __int128 a, unsigned __int128 b) {
+    int shift = trailingZeros(a | b);
+    a >>= trailingZeros(a);
+    while (b) {
+        b >>= trailingZeros(b);
+        if (a > b) {
+            swap(a, b);
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+
+void Rational::reduce(__int128 n, __int128 d) {
+    unsigned __int128 g = gcd128(n < 0 ? -(unsigned __int128)n : (unsigned __int128)n, (unsigned __int128)d);
+    n /= (__int128)g;
+    d /= (__int128)g;
+    if (fitsInline(n) && fitsInline(d)) {
+        num = (int64_t)n;
+        den = (int64_t)d;
+        big.reset();
+    } else {
+        assign(BigInt(n), BigInt(d));
+    }
+}
+
+void Rational::assign(BigInt n, BigInt d) {
+    if (d.sign() < 0) {
+        n = -n;
+        d = -d;
+    }
+    // A full reduction is left to toString. Dividing out the common powers of
+    // two is cheap and keeps fractions from binary payoffs small.
+    int shift = n.isZero() ? d.trailingZeros() : min(n.trailingZeros(), d.trailingZeros());
+    n >>= shift;
+    d >>= shift;
+    __int128 small_n, small_d;
+    if (n.toInt128(small_n) && d.toInt128(small_d) && fitsInline(small_n) && fitsInline(small_d)) {
+        num = (int64_t)small_n;
+        den = (int64_t)small_d;
+        big.reset();
+    } else {
+        num = 0;
+        den = 1;
+        big = make_shared<const Big>(Big{n, d});
+    }
+}
+
+bool Rational::fromDouble(double value, Rational& result) {
+    if (!isfinite(value)) {
+        return false;
+    }
+    // Most payoffs are small integers
+    if (value >= -9007199254740992.0 && value <= 9007199254740992.0 && value == (double)(int64_t)value) {
+        result = Rational((int64_t)value);
+        return true;
+    }
+    // value = mantissa * 2^exponent with a 53-bit integer mantissa
+    int exponent;
+    double fraction = frexp(value, &exponent);
+    int64_t mantissa = (int64_t)ldexp(fraction, 53);
+    exponent -= 53;
+    int shift = min(__builtin_ctzll((uint64_t)(mantissa < 0 ? -mantissa : mantissa)), max(0, -exponent));
+    mantissa >>= shift;
+    exponent += shift;
+    
+    if (exponent <= 0 && -exponent <= 62) {
+        result.set((__int128)mantissa, (__int128)1 << -exponent);
+        return true;
+    }
+    BigInt n(mantissa);
+    BigInt d(1);
+    if (exponent > 0) {
+        n <<= exponent;
+    } else {
+        d <<= -exponent;
+    }
+    result.assign(n, d);
+    return true;
+}
+
+double Rational::toDouble() const {
+    if (!big) {
+        return (double)num / (double)den;
+    }
+    int num_exponent, den_exponent;
+    double n = big->num.scaled(num_exponent);
+    double d = big->den.scaled(den_exponent);
+    return ldexp(n / d, num_exponent - den_exponent);
+}
+
+string Rational::toString() const {
+    if (!big) {
+        if (num == 0) {
+            return "0";
+        }
+        int64_t g = (int64_t)gcd128(num < 0 ? -(unsigned __int128)num : (unsigned __int128)num, den);
+        int64_t n = num / g;
+        int64_t d = den / g;
+        return d == 1 ? to_string(n) : to_string(n) + "/" + to_string(d);
+    }
+    BigInt n = big->num;
+    BigInt d = big->den;
+    BigInt g = BigInt::gcd(n, d);
+    BigInt remainder;
+    BigInt::divide(n, g, n, remainder);
+    BigInt::divide(d, g, d, remainder);
+    string text = n.toString();
+    if (compare(d, BigInt(1)) != 0) {
+        text += "/" + d.toString();
+    }
+    return text;
+}
+
+Rational Rational::addBig(const Rational& a, const Rational& b, int sign) {
+    Rational result;
+    BigInt product = b.bigNum() * a.bigDen();
+    result.assign(sign > 0 ? a.bigNum() * b.bigDen() + product : a.bigNum() * b.bigDen() - product,
+                  a.bigDen() * b.bigDen());
+    return result;
+}
+
+Rational Rational::multiplyBig(const Rational& a, const Rational& b) {
+    Rational result;
+    result.assign(a.bigNum() * b.bigNum(), a.bigDen() * b.bigDen());
+    return result;
+}
+
+Rational Rational::divideBig(const Rational& a, const Rational& b) {
+    Rational result;
+    result.assign(a.bigNum() * b.bigDen(), a.bigDen() * b.bigNum());
+    return result;
+}
+
+Rational Rational::negateBig(const Rational& a) {
+    Rational result;
+    result.big = make_shared<const Big>(Big{-a.big->num, a.big->den});
+    return result;
+}
+
+int Rational::compareBig(const Rational& a, const Rational& b) {
+    return compare(a.bigNum() * b.bigDen(), b.bigNum() * a.bigDen());
+}
@@ -0,0 +1,200 @@
+#ifndef RATIONAL_H
+#define RATIONAL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Arbitrary-precision signed integer, the fallback of Rational. Only the few
+// operations exact solving needs are provided, in schoolbook form: the numbers
+// involved are at most a few hundred bits.
+class BigInt {
+private:
+    bool negative;
+    vector<uint32_t> limbs; // Magnitude, least significant limb first, no leading zero limbs
+    
+    void trim();
+    static int compareMagnitude(const BigInt& a, const BigInt& b);
+    static void addMagnitude(BigInt& a, const BigInt& b);
+    static void subtractMagnitude(BigInt& a, const BigInt& b); // Requires |a| >= |b|
+
+public:
+    BigInt() : negative(false) {}
+    BigInt(__int128 value);
+    
+    bool isZero() const { return limbs.empty(); }
+    int sign() const { return isZero() ? 0 : (negative ? -1 : 1); }
+    BigInt abs() const;
+    int bitLength() const;
+    int trailingZeros() const; // Of the magnitude; 0 for zero
+    
+    // The value as a 128-bit integer; returns false if it does not fit
+    bool toInt128(__int128& value) const;
+    
+    // The value as mantissa * 2^exponent, the mantissa below 2^64 in magnitude
+    double scaled(int& exponent) const;
+    
+    // Nearest double, or +-inf when out of range
+    double toDouble() const;
+    
+    string toString() const;
+    
+    BigInt& operator+=(const BigInt& other);
+    BigInt& operator-=(const BigInt& other);
+    BigInt& operator<<=(int bits);
+    BigInt& operator>>=(int bits); // Of the magnitude
+    
+    friend BigInt operator+(BigInt a, const BigInt& b) { return a += b; }
+    friend BigInt operator-(BigInt a, const BigInt& b) { return a -= b; }
+    friend BigInt operator-(BigInt a) {
+        a.negative = !a.negative && !a.isZero();
+        return a;
+    }
+    friend BigInt operator*(const BigInt& a, const BigInt& b);
+    
+    // Truncating division, with the signs of C's / and %; the results may alias a or b
+    static void divide(BigInt a, BigInt b, BigInt& quotient, BigInt& remainder);
+    static BigInt gcd(BigInt a, BigInt b);
+    
+    friend int compare(const BigInt& a, const BigInt& b);
+};
+
+// Exact rational number. Values whose numerator and denominator fit in 64 bits
+// are kept inline and combined with 128-bit intermediates, so typical games
+// with small integer payoffs never allocate. Inline fractions are reduced only
+// when a result would not fit otherwise; one that still does not fit moves to
+// BigInt, and a big result that fits moves back again. Big fractions only have
+// common powers of two divided out. The denominator is always positive.
+class Rational {
+private:
+    struct Big {
+        BigInt num;
+        BigInt den;
+    };
+    
+    int64_t num;
+    int64_t den;
+    shared_ptr<const Big> big; // Set only when the value does not fit in 64 bits
+    
+    // Inline values keep |num| <= INT64_MAX, so sums of two products cannot overflow 128 bits
+    static bool fitsInline(__int128 value) {
+        return value >= -(__int128)INT64_MAX && value <= (__int128)INT64_MAX;
+    }
+    
+    // Store n / d. Fractions are reduced only when they would not fit
+    // otherwise: the gcd costs more than the arithmetic, and comparisons do
+    // not need reduced operands.
+    void set(__int128 n, __int128 d) {
+        if (d < 0) {
+            n = -n;
+            d = -d;
+        }
+        if (n == 0) {
+            d = 1;
+        }
+        if (fitsInline(n) && fitsInline(d)) {
+            num = (int64_t)n;
+            den = (int64_t)d;
+            big.reset();
+        } else {
+            reduce(n, d);
+        }
+    }
+    
+    // The slow paths: reduce a fraction that does not fit, and BigInt arithmetic
+    void reduce(__int128 n, __int128 d);
+    void assign(BigInt n, BigInt d);
+    BigInt bigNum() const { return big ? big->num : BigInt(num); }
+    BigInt bigDen() const { return big ? big->den : BigInt(den); }
+    static Rational addBig(const Rational& a, const Rational& b, int sign);
+    static Rational multiplyBig(const Rational& a, const Rational& b);
+    static Rational divideBig(const Rational& a, const Rational& b);
+    static Rational negateBig(const Rational& a);
+    static int compareBig(const Rational& a, const Rational& b);
+
+public:
+    Rational(int64_t n = 0) : num(n), den(1) {}
+    Rational(int64_t n, int64_t d) { set((__int128)n, (__int128)d); }
+    
+    // The exact value of a finite double; returns false for NaN and infinities
+    static bool fromDouble(double value, Rational& result);
+    
+    bool isBig() const { return big != nullptr; }
+    int sign() const { return big ? big->num.sign() : (num > 0) - (num < 0); }
+    
+    // Nearest double (to within an ulp or two)
+    double toDouble() const;
+    
+    // "n" or "n/d" in lowest terms
+    string toString() const;
+    
+    friend Rational operator+(const Rational& a, const Rational& b) {
+        if (a.big || b.big) {
+            return addBig(a, b, 1);
+        }
+        Rational result;
+        result.set((__int128)a.num * b.den + (__int128)b.num * a.den, (__int128)a.den * b.den);
+        return result;
+    }
+    
+    friend Rational operator-(const Rational& a, const Rational& b) {
+        if (a.big || b.big) {
+            return addBig(a, b, -1);
+        }
+        Rational result;
+        result.set((__int128)a.num * b.den - (__int128)b.num * a.den, (__int128)a.den * b.den);
+        return result;
+    }
+    
+    friend Rational operator*(const Rational& a, const Rational& b) {
+        if (a.big || b.big) {
+            return multiplyBig(a, b);
+        }
+        Rational result;
+        result.set((__int128)a.num * b.num, (__int128)a.den * b.den);
+        return result;
+    }
+    
+    // b must not be zero
+    friend Rational operator/(const Rational& a, const Rational& b) {
+        if (a.big || b.big) {
+            return divideBig(a, b);
+        }
+        Rational result;
+        result.set((__int128)a.num * b.den, (__int128)a.den * b.num);
+        return result;
+    }
+    
+    friend Rational operator-(const Rational& a) {
+        if (a.big) {
+            return negateBig(a);
+        }
+        Rational result = a;
+        result.num = -a.num;
+        return result;
+    }
+    
+    Rational& operator+=(const Rational& other) { return *this = *this + other; }
+    Rational& operator-=(const Rational& other) { return *this = *this - other; }
+    
+    friend int compare(const Rational& a, const Rational& b) {
+        if (a.big || b.big) {
+            return compareBig(a, b);
+        }
+        __int128 left = (__int128)a.num * b.den;
+        __int128 right = (__int128)b.num * a.den;
+        return (left > right) - (left < right);
+    }
+    
+    friend bool operator==(const Rational& a, const Rational& b) { return compare(a, b) == 0; }
+    friend bool operator!=(const Rational& a, const Rational& b) { return compare(a, b) != 0; }
+    friend bool operator<(const Rational& a, const Rational& b) { return compare(a, b) < 0; }
+    friend bool operator>(const Rational& a, const Rational& b) { return compare(a, b) > 0; }
+    friend bool operator<=(const Rational& a, const Rational& b) { return compare(a, b) <= 0; }
+    friend bool operator>=(const Rational& a, const Rational& b) { return compare(a, b) >= 0; }
+};
+
+#endif // RATIONAL_H
@@ -0,0 +1,44 @@
+#include "solver_stats.h"
+#include <cstdio>
+
+using namespace std;
+
+const char* solverCounterName(SolverCounter counter) {
+    switch (counter) {
+        case SolverCounter::PayoffEvaluations: return "payoff_evaluations";
+        case SolverCounter::BestResponseCalls: return "best_response_calls";
+        case SolverCounter::GridPoints: return "grid_points";
+        case SolverCounter::SubgamesSolved: return "subgames_solved";
+        default: return "unknown";
+    }
+}
+
+const char* solverPhaseName(SolverPhase phase) {
+    switch (phase) {
+        case SolverPhase::PureNash: return "pure_nash";
+        case SolverPhase::MixedNash: return "mixed_nash";
+        case SolverPhase::NonMyopic: return "non_myopic";
+        case SolverPhase::SubgameExtraction: return "subgame_extraction";
+        case SolverPhase::Voting: return "voting";
+        default: return "unknown";
+    }
+}
+
+string solverStatsToJson(const SolverStats& stats) {
+    string json = GAMESOLVER_ENABLE_STATS ? "{\"enabled\": true, \"counters\": {" : "{\"enabled\": false, \"counters\": {";
+    char buffer[128];
+    for (size_t i = 0; i < stats.counters.size(); i++) {
+        snprintf(buffer, sizeof(buffer), "%s\"%s\": %llu", i ? ", " : "", solverCounterName((SolverCounter)i),
+                 (unsigned long long)stats.counters[i]);
+        json += buffer;
+    }
+    json += "}, \"phases\": {";
+    for (size_t i = 0; i < stats.phase_calls.size(); i++) {
+        snprintf(buffer, sizeof(buffer), "%s\"%s\": {\"calls\": %llu, \"seconds\": %.9g}", i ? ", " : "",
+                 solverPhaseName((SolverPhase)i), (unsigned long long)stats.phase_calls[i],
+                 stats.seconds((SolverPhase)i));
+        json += buffer;
+    }
+    json += "}}";
+    return json;
+}
@@ -0,0 +1,118 @@
+#ifndef SOLVER_STATS_H
+#define SOLVER_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// Optional instrumentation of the solver hot paths. Build with
+// GAMESOLVER_ENABLE_STATS=1 (CMake option GAMESOLVER_STATS) to count work and
+// time each solver phase; otherwise the GAMESOLVER_COUNT and GAMESOLVER_PHASE
+// macros expand to nothing and the solvers compile exactly as without them.
+#ifndef GAMESOLVER_ENABLE_STATS
+#define GAMESOLVER_ENABLE_STATS 0
+#endif
+
+// Units of work counted by the solvers
+enum class SolverCounter : uint8_t {
+    PayoffEvaluations, // Expected payoffs computed for a mixed profile
+    BestResponseCalls, // findBestResponse calls
+    GridPoints,        // Profiles or mixes visited by the grid searches
+    SubgamesSolved,    // 2x2 subgames solved by Game3x3Solver (cache misses)
+    Count
+};
+
+// Timed solver phases; a phase's time includes any phase nested inside it
+enum class SolverPhase : uint8_t {
+    PureNash,
+    MixedNash,
+    NonMyopic,
+    SubgameExtraction,
+    Voting,
+    Count
+};
+
+const char* solverCounterName(SolverCounter counter);
+const char* solverPhaseName(SolverPhase phase);
+
+// Counters and phase timers of one thread
+struct SolverStats {
+    array<uint64_t, (size_t)SolverCounter::Count> counters;
+    array<uint64_t, (size_t)SolverPhase::Count> phase_calls;
+    array<uint64_t, (size_t)SolverPhase::Count> phase_nanoseconds;
+    
+    SolverStats() { reset(); }
+    
+    void reset() {
+        counters.fill(0);
+        phase_calls.fill(0);
+        phase_nanoseconds.fill(0);
+    }
+    
+    uint64_t count(SolverCounter counter) const { return counters[(size_t)counter]; }
+    uint64_t calls(SolverPhase phase) const { return phase_calls[(size_t)phase]; }
+    double seconds(SolverPhase phase) const { return phase_nanoseconds[(size_t)phase] * 1e-9; }
+    
+    // Add another thread's stats, e.g. when collecting the workers of a pool
+    SolverStats& operator+=(const SolverStats& other) {
+        for (size_t i = 0; i < counters.size(); i++) {
+            counters[i] += other.counters[i];
+        }
+        for (size_t i = 0; i < phase_calls.size(); i++) {
+            phase_calls[i] += other.phase_calls[i];
+            phase_nanoseconds[i] += other.phase_nanoseconds[i];
+        }
+        return *this;
+    }
+};
+
+// Stats of the calling thread. Always available; all zero when instrumentation is compiled out.
+inline SolverStats& threadSolverStats() {
+    static thread_local SolverStats stats;
+    return stats;
+}
+
+// JSON object with every counter and phase, e.g.
+// {"enabled": true, "counters": {"payoff_evaluations": 12, ...},
+//  "phases": {"pure_nash": {"calls": 1, "seconds": 1.2e-07}, ...}}
+string solverStatsToJson(const SolverStats& stats);
+
+// Adds the time from construction to destruction to a phase of the calling thread
+class SolverPhaseTimer {
+private:
+    SolverPhase phase;
+    chrono::steady_clock::time_point start;
+
+public:
+    explicit SolverPhaseTimer(SolverPhase p) : phase(p), start(chrono::steady_clock::now()) {}
+    
+    ~SolverPhaseTimer() {
+        SolverStats& stats = threadSolverStats();
+        stats.phase_calls[(size_t)phase]++;
+        stats.phase_nanoseconds[(size_t)phase] +=
+            (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    }
+    
+    SolverPhaseTimer(const SolverPhaseTimer&) = delete;
+    SolverPhaseTimer& operator=(const SolverPhaseTimer&) = delete;
+};
+
+#define GAMESOLVER_STATS_CONCAT2(a, b) a##b
+#define GAMESOLVER_STATS_CONCAT(a, b) GAMESOLVER_STATS_CONCAT2(a, b)
+
+#if GAMESOLVER_ENABLE_STATS
+// Add n to a SolverCounter of the calling thread
+#define GAMESOLVER_COUNT(counter, n) \
+    (threadSolverStats().counters[(size_t)SolverCounter::counter] += (uint64_t)(n))
+// Time the rest of the enclosing scope as a SolverPhase
+#define GAMESOLVER_PHASE(phase) \
+    SolverPhaseTimer GAMESOLVER_STATS_CONCAT(solver_phase_timer_, __LINE__)(SolverPhase::phase)
+#else
+#define GAMESOLVER_COUNT(counter, n) ((void)0)
+#define GAMESOLVER_PHASE(phase) ((void)0)
+#endif
+
+#endif // SOLVER_STATS_H
@@ -0,0 +1,1253 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "adaptive_grid.h"
+#include "compressed_game.h"
+#include "equilibrium_cache.h"
+#include "game_3x3.h"
+#include "game_io.h"
+#include "game_report.h"
+#include "game_session.h"
+#include "game_solver.h"
+#include "nash_engine.h"
+#include "nplayer_game.h"
+#include "parallel_batch.h"
+#include "parametric_sweep.h"
+#include "pure_nash.h"
+#include "rational.h"
+#include "solver_stats.h"
+#include "text_batch.h"
+
+using namespace std;
+
+// Cross-checks between the solvers: each check compares a fast or incremental
+// path against a direct one on seeded random games and reports the first
+// mismatch. Run all checks, or only those named on the command line; the
+// exit status is nonzero if any fails.
+
+static bool fail(const string& check, const string& message) {
+    cout << check << ": " << message << endl;
+    return false;
+}
+
+static bool near(double a, double b, double tolerance = 1e-6) {
+    return fabs(a - b) <= tolerance * max(1.0, max(fabs(a), fabs(b)));
+}
+
+template<class GameT>
+static void randomPayoffs(GameT& game, mt19937_64& rng, int lo, int hi) {
+    uniform_int_distribution<int> payoff(lo, hi);
+    for (int i = 0; i < game.rows(); i++) {
+        for (int j = 0; j < game.cols(); j++) {
+            for (int k = 0; k < 2; k++) {
+                game.setPayoff(i, j, k, payoff(rng));
+            }
+        }
+    }
+}
+
+template<class GameT>
+static void randomRealPayoffs(GameT& game, mt19937_64& rng) {
+    uniform_real_distribution<double> payoff(-10.0, 10.0);
+    for (int i = 0; i < game.rows(); i++) {
+        for (int j = 0; j < game.cols(); j++) {
+            for (int k = 0; k < 2; k++) {
+                game.setPayoff(i, j, k, payoff(rng));
+            }
+        }
+    }
+}
+
+static bool sameEquilibria(const vector<Equilibrium>& a, const vector<Equilibrium>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < a.size(); k++) {
+        if (a[k].kind != b[k].kind || a[k].isContinuum != b[k].isContinuum ||
+            !near(a[k].profile.p1_strategy1_prob, b[k].profile.p1_strategy1_prob) ||
+            !near(a[k].profile.p2_strategy1_prob, b[k].profile.p2_strategy1_prob) ||
+            !near(a[k].profile_end.p1_strategy1_prob, b[k].profile_end.p1_strategy1_prob) ||
+            !near(a[k].profile_end.p2_strategy1_prob, b[k].profile_end.p2_strategy1_prob)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool sameMixes(const vector<double>& a, const vector<double>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < a.size(); k++) {
+        if (!near(a[k], b[k])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Same equilibria in any order
+static bool sameEquilibriumSets(const vector<MixedEquilibrium>& a, const vector<MixedEquilibrium>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (const auto& x : a) {
+        bool found = false;
+        for (const auto& y : b) {
+            if (sameMixes(x.row_strategy, y.row_strategy) && sameMixes(x.col_strategy, y.col_strategy)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool samePureProfiles(const vector<PureProfile>& a, const vector<PureProfile>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < a.size(); k++) {
+        if (a[k].row != b[k].row || a[k].col != b[k].col) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Out-of-range setPayoff calls leave the game and the solver state untouched
+bool checkSetPayoffBounds() {
+    Game2x2 game;
+    mt19937_64 rng(1);
+    randomPayoffs(game, rng, -5, 5);
+    NormalFormSolver solver(game);
+    const int bad[][3] = {{2, 0, 0}, {0, 2, 1}, {0, 0, 2}, {-1, 0, 0}, {0, -1, 0}, {0, 0, -1}};
+    for (const auto& b : bad) {
+        solver.setPayoff(b[0], b[1], b[2], 99.0);
+    }
+    if (!samePayoffs(solver.getGame(), game)) {
+        return fail("set_payoff_bounds", "NormalFormSolver payoffs changed");
+    }
+    if (solver.getGridSearchOptions().coarse_intervals != 16 || solver.getGridSearchOptions().precision != 1e-9) {
+        return fail("set_payoff_bounds", "NormalFormSolver grid options changed");
+    }
+    
+    Game3x3 game3x3;
+    randomPayoffs(game3x3, rng, -5, 5);
+    GameSession3x3 session(game3x3);
+    const int bad3x3[][3] = {{3, 0, 0}, {0, 3, 1}, {0, 0, 2}, {-1, 0, 0}, {0, -1, 0}, {0, 0, -1}};
+    for (const auto& b : bad3x3) {
+        session.setPayoff(b[0], b[1], b[2], 99.0);
+    }
+    if (!samePayoffs(session.getGame(), game3x3) || session.staleSubgames() != 0) {
+        return fail("set_payoff_bounds", "GameSession3x3 state changed");
+    }
+    return true;
+}
+
+// A session edited payoff by payoff predicts what a fresh solver predicts
+bool checkSession() {
+    mt19937_64 rng(2);
+    uniform_int_distribution<int> index(0, 2);
+    uniform_int_distribution<int> player(0, 1);
+    uniform_int_distribution<int> payoff(-5, 5);
+    for (int trial = 0; trial < 200; trial++) {
+        Game3x3 game;
+        randomPayoffs(game, rng, -5, 5);
+        GameSession3x3 session(game);
+        for (int edit = 0; edit < 5; edit++) {
+            int row = index(rng);
+            int col = index(rng);
+            int k = player(rng);
+            double value = payoff(rng);
+            session.setPayoff(row, col, k, value);
+            game.setPayoff(row, col, k, value);
+            
+            Game3x3Solver solver(game);
+            SubgamePrediction expected = solver.calculate3x3NMEFromSubgames();
+            SubgamePrediction actual = session.calculate3x3NMEFromSubgames();
+            if (actual.outcome_votes != expected.outcome_votes || actual.max_votes != expected.max_votes ||
+                actual.votes.size() != expected.votes.size()) {
+                return fail("session", "vote counts differ from Game3x3Solver");
+            }
+            if (!samePureProfiles(session.findPureNashEquilibria(), solver.findPureNashEquilibria())) {
+                return fail("session", "pure equilibria differ from Game3x3Solver");
+            }
+        }
+    }
+    return true;
+}
+
+// Non-myopic equilibria of known games. At the opponent's indifference point
+// the anticipating player gets no favourable tie-break: the point is dropped
+// when another profile attains the same payoff (first game, the subgame on
+// rows 1, 3 and columns 1, 2 of the 3x3 example) or when only the tie reaches
+// it (second), and kept as the limit of the grid when nothing attains it (third).
+bool checkNonMyopic() {
+    struct Known {
+        double payoffs[8];
+        double p;
+        double q;
+    };
+    const Known known[] = {
+        {{3, 3, 0, 5, 1, 2, 2, 4}, 0.0, 0.0},
+        {{1, 4, 1, 3, 3, 2, 1, 1}, 0.0, 1.0},
+        {{2, 3, 1, 2, 4, 0, 2, 1}, 0.5, 0.0},
+        {{3, 3, 0, 5, 5, 0, 1, 1}, 0.0, 0.0},
+    };
+    for (const Known& k : known) {
+        Game2x2 game;
+        copy(k.payoffs, k.payoffs + 8, game.payoffs.begin());
+        NormalFormSolver solver(game);
+        vector<Equilibrium> expected = {Equilibrium(StrategyProfile(k.p, k.q), EquilibriumKind::NonMyopic)};
+        if (!sameEquilibria(solver.findNonMyopicEquilibria(SolverMode::Analytic), expected) ||
+            !sameEquilibria(solver.findNonMyopicEquilibria(SolverMode::Exact), expected)) {
+            return fail("non_myopic", "unexpected equilibria for a known game");
+        }
+    }
+    
+    // A player indifferent everywhere: every profile is non-myopic
+    Game2x2 flat;
+    flat.payoffs.fill(1.0);
+    vector<Equilibrium> everything = {Equilibrium(StrategyProfile(0, 0), StrategyProfile(1, 1), EquilibriumKind::NonMyopic)};
+    if (!sameEquilibria(NormalFormSolver(flat).findNonMyopicEquilibria(), everything)) {
+        return fail("non_myopic", "a constant game is not a continuum of equilibria");
+    }
+    
+    // Votes of the 3x3 example of game_3x3_solver
+    const double example[18] = {3, 3, 0, 5, 2, 1, 5, 0, 1, 1, 4, 2, 1, 2, 2, 4, 6, 6};
+    Game3x3 game3x3;
+    copy(example, example + 18, game3x3.payoffs.begin());
+    SubgamePrediction prediction = Game3x3Solver(game3x3).calculate3x3NMEFromSubgames();
+    if (prediction.row_votes != array<int, 3>{0, 3, 6} || prediction.col_votes != array<int, 3>{0, 3, 6} ||
+        prediction.max_votes != 4) {
+        return fail("non_myopic", "unexpected votes for the 3x3 example");
+    }
+    return true;
+}
+
+// solveCached matches a direct analytic solve, on repeated and fresh games
+bool checkSolveCached() {
+    mt19937_64 rng(3);
+    EquilibriumCache2x2 cache(1 << 10);
+    for (int trial = 0; trial < 2000; trial++) {
+        Game2x2 game;
+        randomPayoffs(game, rng, -3, 3);
+        NormalFormSolver solver(game);
+        GameSolution2x2 cached = solveCached(game, cache);
+        if (!sameEquilibria(cached.nash_equilibria, solver.findAllNashEquilibria())) {
+            return fail("solve_cached", "Nash equilibria differ from a direct solve");
+        }
+        if (!sameEquilibria(cached.non_myopic_equilibria, solver.findNonMyopicEquilibria())) {
+            return fail("solve_cached", "non-myopic equilibria differ from a direct solve");
+        }
+    }
+    return true;
+}
+
+// Exact rational solving agrees with the analytic solver on games without
+// ties, where rounding cannot change the answer. On small-integer games, full
+// of ties, its answer is unchanged by a positive affine rescaling of each
+// player's payoffs, which moves the rounding of the double solver around, and
+// it resolves the README's tie example that double arithmetic gets wrong.
+bool checkExactMode() {
+    mt19937_64 rng(4);
+    for (int trial = 0; trial < 2000; trial++) {
+        Game2x2 game;
+        randomRealPayoffs(game, rng);
+        NormalFormSolver solver(game);
+        if (!sameEquilibria(solver.findAllNashEquilibria(SolverMode::Exact),
+                            solver.findAllNashEquilibria(SolverMode::Analytic))) {
+            return fail("exact_mode", "Exact and Analytic Nash equilibria differ");
+        }
+        if (!sameEquilibria(solver.findNonMyopicEquilibria(SolverMode::Exact),
+                            solver.findNonMyopicEquilibria(SolverMode::Analytic))) {
+            return fail("exact_mode", "Exact and Analytic non-myopic equilibria differ");
+        }
+    }
+    
+    for (int trial = 0; trial < 5000; trial++) {
+        Game2x2 game;
+        randomPayoffs(game, rng, -3, 3);
+        Game2x2 scaled;
+        for (int k = 0; k < 8; k++) {
+            scaled.payoffs[k] = k % 2 == 0 ? 3 * game.payoffs[k] + 7 : 5 * game.payoffs[k] - 2;
+        }
+        NormalFormSolver solver(game);
+        NormalFormSolver scaled_solver(scaled);
+        vector<Equilibrium> nme = solver.findNonMyopicEquilibria(SolverMode::Exact);
+        if (!sameEquilibria(solver.findAllNashEquilibria(SolverMode::Exact),
+                            solver.findAllNashEquilibria(SolverMode::Analytic)) ||
+            !sameEquilibria(scaled_solver.findAllNashEquilibria(SolverMode::Exact),
+                            solver.findAllNashEquilibria(SolverMode::Exact))) {
+            return fail("exact_mode", "Exact Nash equilibria of an integer game differ");
+        }
+        if (nme.empty() || !sameEquilibria(scaled_solver.findNonMyopicEquilibria(SolverMode::Exact), nme)) {
+            return fail("exact_mode", "Exact non-myopic equilibria change under rescaling");
+        }
+    }
+    
+    // The tie example of the README: p = 0 attains the supremum at p = 1/3
+    Game2x2 tie;
+    const double tie_payoffs[8] = {1, 0, 1, 4, 3, 4, 4, 2};
+    copy(tie_payoffs, tie_payoffs + 8, tie.payoffs.begin());
+    vector<ExactEquilibrium> exact;
+    if (!NormalFormSolver(tie).findNonMyopicEquilibriaExact(exact) || exact.size() != 1 || exact[0].isContinuum || exact[0].profile.p1_strategy1_prob != Rational(0) ||
+        exact[0].profile.p2_strategy1_prob != Rational(1)) {
+        return fail("exact_mode", "wrong non-myopic equilibrium for the README tie example");
+    }
+    return true;
+}
+
+// Rational arithmetic matches 128-bit integer arithmetic, including values
+// that outgrow 64 bits and move to BigInt and back
+bool checkRational() {
+    mt19937_64 rng(5);
+    uniform_int_distribution<int64_t> value(-1000000, 1000000);
+    for (int trial = 0; trial < 10000; trial++) {
+        int64_t a = value(rng), b = value(rng), c = value(rng), d = value(rng);
+        if (b == 0 || d == 0 || c == 0) {
+            continue;
+        }
+        Rational x(a, b), y(c, d);
+        // a/b + c/d == (ad + cb) / bd, compared by cross-multiplying in 128 bits
+        if ((x + y) * Rational(b) * Rational(d) != Rational(a * d + c * b) || (x / y) * y != x ||
+            (x - y) + y != x || !near((x * y).toDouble(), ((double)a / b) * ((double)c / d), 1e-12)) {
+            return fail("rational", "arithmetic mismatch for " + x.toString() + " and " + y.toString());
+        }
+    }
+    
+    Rational x((int64_t)1 << 62, 3);
+    Rational cube = x * x * x;
+    if (!cube.isBig()) {
+        return fail("rational", "2^186 / 27 is stored inline");
+    }
+    Rational back = cube / x / x;
+    if (back != x) {
+        return fail("rational", "BigInt round trip gives " + back.toString());
+    }
+    if (!near(cube.toDouble(), ldexp(1.0, 186) / 27.0, 1e-12)) {
+        return fail("rational", "BigInt toDouble is off");
+    }
+    return true;
+}
+
+// Support enumeration on random real games, nondegenerate with probability
+// one, finds an odd number of equilibria, each without a profitable deviation
+// and unchanged by the strict dominance pre-pass. Lemke-Howson from every
+// initial label ends at one of them. Rock-paper-scissors has only the uniform one.
+bool checkNashEngine() {
+    mt19937_64 rng(13);
+    uniform_int_distribution<int> size(2, 6);
+    for (int trial = 0; trial < 300; trial++) {
+        DynamicGame game(size(rng), size(rng));
+        randomRealPayoffs(game, rng);
+        NashEngine<DynamicGame> engine(game);
+        BimatrixSolver<DynamicGame> solver(game);
+        vector<MixedEquilibrium> all = engine.supportEnumeration();
+        if (all.size() % 2 == 0) {
+            return fail("nash_engine", to_string(all.size()) + " equilibria in a nondegenerate game");
+        }
+        for (const MixedEquilibrium& eq : all) {
+            if (!solver.isNashEquilibrium(eq.row_strategy.data(), eq.col_strategy.data())) {
+                return fail("nash_engine", "support enumeration returned a non-equilibrium");
+            }
+        }
+        if (!sameEquilibriumSets(all, NashEngine<DynamicGame>(game, DominanceMode::None).supportEnumeration())) {
+            return fail("nash_engine", "the dominance pre-pass changed the equilibria");
+        }
+        for (int label = 0; label < game.rows() + game.cols(); label++) {
+            MixedEquilibrium eq;
+            if (!engine.lemkeHowson(eq, label)) {
+                return fail("nash_engine", "Lemke-Howson did not terminate from label " + to_string(label));
+            }
+            bool found = any_of(all.begin(), all.end(), [&eq](const MixedEquilibrium& other) {
+                return sameMixes(eq.row_strategy, other.row_strategy) && sameMixes(eq.col_strategy, other.col_strategy);
+            });
+            if (!found) {
+                return fail("nash_engine", "Lemke-Howson from label " + to_string(label) +
+                            " ended outside the support enumeration");
+            }
+        }
+    }
+    
+    DynamicGame rps(3, 3);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            double payoff = (j - i + 3) % 3 == 1 ? -1.0 : (i - j + 3) % 3 == 1 ? 1.0 : 0.0;
+            rps.setPayoff(i, j, 0, payoff);
+            rps.setPayoff(i, j, 1, -payoff);
+        }
+    }
+    MixedEquilibrium uniform;
+    uniform.row_strategy.assign(3, 1.0 / 3.0);
+    uniform.col_strategy.assign(3, 1.0 / 3.0);
+    MixedEquilibrium sampled;
+    if (!sameEquilibriumSets(NashEngine<DynamicGame>(rps).supportEnumeration(), {uniform}) ||
+        !NashEngine<DynamicGame>(rps).lemkeHowson(sampled) || !sameEquilibriumSets({sampled}, {uniform})) {
+        return fail("nash_engine", "rock-paper-scissors does not give the uniform equilibrium");
+    }
+    return true;
+}
+
+// Support enumeration through the canonical form cache matches a direct run.
+// Rescaled integer games hit the cache, and games that a rounded
+// normalization would merge keep distinct forms.
+bool checkCanonicalCache() {
+    mt19937_64 rng(6);
+    EquilibriumCache<DynamicGame, vector<MixedEquilibrium>> cache(1 << 10);
+    DynamicGame game(3, 3);
+    for (int trial = 0; trial < 500; trial++) {
+        // Even games are fresh, with real or integer payoffs; odd games repeat
+        // the previous one with its rows reversed and its payoffs rescaled
+        if (trial % 4 == 0) {
+            randomRealPayoffs(game, rng);
+        } else if (trial % 4 == 2) {
+            randomPayoffs(game, rng, -5, 5);
+        } else {
+            DynamicGame scaled(3, 3);
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    scaled.setPayoff(2 - i, j, 0, 2.0 * game.getPayoff(i, j, 0) + 1.0);
+                    scaled.setPayoff(2 - i, j, 1, 3.0 * game.getPayoff(i, j, 1) - 4.0);
+                }
+            }
+            game = scaled;
+        }
+        vector<MixedEquilibrium> cached = supportEnumerationCached(game, cache);
+        vector<MixedEquilibrium> direct = NashEngine<DynamicGame>(game).supportEnumeration();
+        if (!sameEquilibriumSets(cached, direct)) {
+            return fail("canonical_cache", "equilibria differ from direct support enumeration");
+        }
+    }
+    if (cache.hits() < 125) {
+        return fail("canonical_cache", "rescaled integer games miss the cache");
+    }
+    
+    // Mapped onto [0, 1], these payoffs of player 1 round to the same values
+    Game2x2 a;
+    const double payoffs[8] = {0.5, 0, 1000.5, 1, 510.6159809286764, 2, 3, 0};
+    copy(payoffs, payoffs + 8, a.payoffs.begin());
+    Game2x2 b = a;
+    b.payoffs[4] = nextafter(a.payoffs[4], 1000.0);
+    CanonicalForm<Game2x2> form_a;
+    CanonicalForm<Game2x2> form_b;
+    if (!canonicalize(a, form_a) || !canonicalize(b, form_b) || samePayoffs(form_a.game, form_b.game)) {
+        return fail("canonical_cache", "distinct non-integer games share a canonical form");
+    }
+    return true;
+}
+
+// A sweep evaluated inside a regime matches a direct solve of the game there
+bool checkSweep() {
+    mt19937_64 rng(7);
+    for (int trial = 0; trial < 500; trial++) {
+        Game2x2 base, slope;
+        randomRealPayoffs(base, rng);
+        randomRealPayoffs(slope, rng);
+        AffineGame2x2 affine(base, slope);
+        ParametricSweep sweep = sweepEquilibria(affine, -1.0, 1.0);
+        for (const SweepRegime& regime : sweep.regimes) {
+            double t = 0.5 * (regime.t_lo + regime.t_hi);
+            NormalFormSolver solver(affine.at(t));
+            if (!sameEquilibria(sweep.nashEquilibriaAt(t), solver.findAllNashEquilibria())) {
+                return fail("sweep", "Nash equilibria at t = " + to_string(t) + " differ from a direct solve");
+            }
+        }
+    }
+    return true;
+}
+
+// Two-player N-player games match the bimatrix solver; equilibria of
+// three-player games leave no profitable deviation
+bool checkNPlayer() {
+    mt19937_64 rng(8);
+    for (int trial = 0; trial < 200; trial++) {
+        DynamicGame bimatrix(3, 3);
+        randomRealPayoffs(bimatrix, rng);
+        NPlayerGame game({3, 3});
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                for (int k = 0; k < 2; k++) {
+                    game.setPayoff({i, j}, k, bimatrix.getPayoff(i, j, k));
+                }
+            }
+        }
+        vector<MixedEquilibrium> expected = NashEngine<DynamicGame>(bimatrix, DominanceMode::None).supportEnumeration();
+        vector<MixedEquilibrium> actual;
+        for (const NPlayerEquilibrium& eq : NPlayerSolver(game).supportEnumeration()) {
+            MixedEquilibrium mixed;
+            mixed.row_strategy = eq.strategies[0];
+            mixed.col_strategy = eq.strategies[1];
+            actual.push_back(mixed);
+        }
+        if (!sameEquilibriumSets(actual, expected)) {
+            return fail("nplayer", "two-player equilibria differ from NashEngine");
+        }
+    }
+    
+    uniform_real_distribution<double> payoff(-10.0, 10.0);
+    for (int trial = 0; trial < 100; trial++) {
+        NPlayerGame game({2, 2, 2});
+        for (double& value : game.payoffs) {
+            value = payoff(rng);
+        }
+        NPlayerSolver solver(game);
+        for (const NPlayerEquilibrium& eq : solver.supportEnumeration()) {
+            if (!solver.isNashEquilibrium(eq.strategies, 1e-6)) {
+                return fail("nplayer", "three-player equilibrium has a profitable deviation");
+            }
+        }
+        for (const vector<int>& profile : solver.findPureNashEquilibria()) {
+            vector<vector<double>> mixes(3, vector<double>(2, 0.0));
+            for (int p = 0; p < 3; p++) {
+                mixes[p][profile[p]] = 1.0;
+            }
+            if (!solver.isNashEquilibrium(mixes)) {
+                return fail("nplayer", "pure three-player equilibrium has a profitable deviation");
+            }
+        }
+    }
+    return true;
+}
+
+// The single-pass screen finds the pure equilibria BimatrixSolver finds,
+// including ties and games wider than one mask word
+bool checkPureScreen() {
+    mt19937_64 rng(9);
+    uniform_int_distribution<int> size(1, 80);
+    for (int trial = 0; trial < 300; trial++) {
+        DynamicGame game(size(rng), size(rng));
+        randomPayoffs(game, rng, 0, 3);
+        if (!samePureProfiles(screenPureNashEquilibria(game), BimatrixSolver<DynamicGame>(game).findPureNashEquilibria())) {
+            return fail("pure_screen", "screened equilibria differ from BimatrixSolver");
+        }
+    }
+    return true;
+}
+
+// Kernels of CompressedGameSolver agree with BimatrixSolver on the dense game
+template<class CompressedT>
+static bool sameKernels(const CompressedT& compressed, const DynamicGame& dense, mt19937_64& rng) {
+    CompressedGameSolver<CompressedT> fast(compressed);
+    BimatrixSolver<DynamicGame> slow(dense);
+    uniform_real_distribution<double> weight(0.0, 1.0);
+    vector<double> row_mix(dense.rows()), col_mix(dense.cols());
+    for (double& p : row_mix) {
+        p = weight(rng);
+    }
+    for (double& p : col_mix) {
+        p = weight(rng);
+    }
+    
+    vector<double> fast_rows(dense.rows()), slow_rows(dense.rows());
+    vector<double> fast_cols(dense.cols()), slow_cols(dense.cols());
+    fast.rowPayoffs(col_mix.data(), fast_rows.data());
+    slow.rowPayoffs(col_mix.data(), slow_rows.data());
+    fast.colPayoffs(row_mix.data(), fast_cols.data());
+    slow.colPayoffs(row_mix.data(), slow_cols.data());
+    return sameMixes(fast_rows, slow_rows) && sameMixes(fast_cols, slow_cols) &&
+           near(fast.expectedPayoff(0, row_mix.data(), col_mix.data()),
+                slow.expectedPayoff(0, row_mix.data(), col_mix.data())) &&
+           near(fast.expectedPayoff(1, row_mix.data(), col_mix.data()),
+                slow.expectedPayoff(1, row_mix.data(), col_mix.data()));
+}
+
+// Sparse and low-rank games give the dense game's payoffs
+bool checkCompressed() {
+    mt19937_64 rng(10);
+    uniform_int_distribution<int> size(1, 40);
+    uniform_real_distribution<double> unit(-1.0, 1.0);
+    for (int trial = 0; trial < 200; trial++) {
+        // Mostly zeros, so sparsify has a base to strip
+        DynamicGame dense(size(rng), size(rng));
+        for (int i = 0; i < dense.rows(); i++) {
+            for (int j = 0; j < dense.cols(); j++) {
+                for (int k = 0; k < 2; k++) {
+                    dense.setPayoff(i, j, k, unit(rng) > 0.7 ? unit(rng) : 0.0);
+                }
+            }
+        }
+        SparseGame sparse = sparsify(dense);
+        if (!sameKernels(sparse, dense, rng)) {
+            return fail("compressed", "sparse kernels differ from the dense game");
+        }
+        
+        int rows = size(rng), cols = size(rng), rank = 3;
+        vector<double> u1(rows * rank), v1(cols * rank), u2(rows * rank), v2(cols * rank);
+        for (vector<double>* factor : {&u1, &v1, &u2, &v2}) {
+            for (double& value : *factor) {
+                value = unit(rng);
+            }
+        }
+        LowRankGame low_rank;
+        if (!buildLowRankGame(rows, cols, rank, u1, v1, rank, u2, v2, low_rank)) {
+            return fail("compressed", "buildLowRankGame rejected valid factors");
+        }
+        DynamicGame expanded(rows, cols);
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                for (int k = 0; k < 2; k++) {
+                    expanded.setPayoff(i, j, k, low_rank.getPayoff(i, j, k));
+                }
+            }
+        }
+        if (!sameKernels(low_rank, expanded, rng)) {
+            return fail("compressed", "low-rank kernels differ from the dense game");
+        }
+    }
+    return true;
+}
+
+// Random 2x2 games as the eight payoff streams of BatchGames2x2: odd games
+// have small integer payoffs, full of ties, and even games real payoffs
+static BatchGames2x2 randomBatch2x2(vector<double>& streams, size_t count, mt19937_64& rng) {
+    uniform_int_distribution<int> integer(-2, 2);
+    uniform_real_distribution<double> real(-10.0, 10.0);
+    streams.resize(8 * count);
+    for (size_t g = 0; g < count; g++) {
+        for (int s = 0; s < 8; s++) {
+            streams[s * count + g] = g % 2 ? integer(rng) : real(rng);
+        }
+    }
+    const double* data = streams.data();
+    return {data, data + count, data + 2 * count, data + 3 * count, data + 4 * count,
+            data + 5 * count, data + 6 * count, data + 7 * count, count};
+}
+
+// Owned result arrays of a batch
+struct BatchOutput2x2 {
+    vector<uint8_t> pure_mask, num_equilibria, flags;
+    vector<double> mixed_p1, mixed_p2;
+    
+    explicit BatchOutput2x2(size_t count)
+        : pure_mask(count), num_equilibria(count), flags(count), mixed_p1(count), mixed_p2(count) {}
+    
+    BatchResults2x2 results() {
+        return {pure_mask.data(), num_equilibria.data(), flags.data(), mixed_p1.data(), mixed_p2.data()};
+    }
+};
+
+// Whether an equilibrium record contains a pure profile. Pure records hold
+// strategy indices, the others probabilities of strategy 1.
+static bool containsCell(const Equilibrium& eq, int row, int col) {
+    if (eq.kind == EquilibriumKind::PureNash) {
+        return eq.profile.p1_strategy1_prob == row && eq.profile.p2_strategy1_prob == col;
+    }
+    double p1 = row == 0 ? 1.0 : 0.0;
+    double p2 = col == 0 ? 1.0 : 0.0;
+    return min(eq.profile.p1_strategy1_prob, eq.profile_end.p1_strategy1_prob) <= p1 &&
+           p1 <= max(eq.profile.p1_strategy1_prob, eq.profile_end.p1_strategy1_prob) &&
+           min(eq.profile.p2_strategy1_prob, eq.profile_end.p2_strategy1_prob) <= p2 &&
+           p2 <= max(eq.profile.p2_strategy1_prob, eq.profile_end.p2_strategy1_prob);
+}
+
+// The batch solver agrees with NormalFormSolver game by game. Every pure
+// equilibrium it reports lies in one of NormalFormSolver's records, which in
+// a degenerate game may be a continuum; on nondegenerate games the pure
+// equilibria, the mixed equilibrium and the equilibrium count are the same.
+bool checkBatchSolver() {
+    mt19937_64 rng(14);
+    const size_t count = 20000;
+    vector<double> streams;
+    BatchGames2x2 games = randomBatch2x2(streams, count, rng);
+    BatchOutput2x2 out(count);
+    size_t degenerate = solveBatch2x2(games, out.results(), BatchKernel::Scalar);
+    
+    size_t expected_degenerate = 0;
+    for (size_t g = 0; g < count; g++) {
+        Game2x2 game;
+        for (int s = 0; s < 8; s++) {
+            game.payoffs[s % 4 * 2 + s / 4] = streams[s * count + g];
+        }
+        vector<Equilibrium> equilibria = NormalFormSolver(game).findAllNashEquilibria();
+        for (int cell = 0; cell < 4; cell++) {
+            bool covered = any_of(equilibria.begin(), equilibria.end(), [cell](const Equilibrium& eq) {
+                return containsCell(eq, cell / 2, cell % 2);
+            });
+            if ((out.pure_mask[g] >> cell & 1) && !covered) {
+                return fail("batch_solver", "game " + to_string(g) + " has a pure equilibrium NormalFormSolver lacks");
+            }
+        }
+        if (out.flags[g] & BATCH_DEGENERATE) {
+            expected_degenerate++;
+            continue;
+        }
+        
+        uint8_t pure_mask = 0;
+        const Equilibrium* mixed = nullptr;
+        for (const Equilibrium& eq : equilibria) {
+            if (eq.kind == EquilibriumKind::PureNash) {
+                pure_mask |= (uint8_t)(1 << (int)(eq.profile.p1_strategy1_prob * 2 + eq.profile.p2_strategy1_prob));
+            } else if (eq.kind == EquilibriumKind::MixedNash) {
+                mixed = &eq;
+            }
+        }
+        bool has_mixed = (out.flags[g] & BATCH_HAS_MIXED) != 0;
+        if (out.pure_mask[g] != pure_mask || out.num_equilibria[g] != equilibria.size() ||
+            has_mixed != (mixed != nullptr) ||
+            (mixed && !(near(out.mixed_p1[g], mixed->profile.p1_strategy1_prob) &&
+                        near(out.mixed_p2[g], mixed->profile.p2_strategy1_prob)))) {
+            return fail("batch_solver", "equilibria of game " + to_string(g) + " differ from NormalFormSolver");
+        }
+    }
+    if (degenerate != expected_degenerate || degenerate == 0 || degenerate == count) {
+        return fail("batch_solver", "unexpected degenerate count " + to_string(degenerate));
+    }
+    return true;
+}
+
+// Same results, with NaN equal to NaN
+static bool sameBatchOutput(const BatchOutput2x2& a, const BatchOutput2x2& b) {
+    auto same = [](double x, double y) { return x == y || (isnan(x) && isnan(y)); };
+    for (size_t g = 0; g < a.pure_mask.size(); g++) {
+        if (a.pure_mask[g] != b.pure_mask[g] || a.num_equilibria[g] != b.num_equilibria[g] ||
+            a.flags[g] != b.flags[g] || !same(a.mixed_p1[g], b.mixed_p1[g]) || !same(a.mixed_p2[g], b.mixed_p2[g])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every batch kernel, on structure-of-arrays and interleaved input, gives the
+// scalar kernel's results exactly. The count leaves a partial vector at the
+// end. A kernel the CPU lacks falls back to the best one it has.
+bool checkBatchKernels() {
+    mt19937_64 rng(15);
+    const size_t count = 20003;
+    vector<double> streams;
+    BatchGames2x2 games = randomBatch2x2(streams, count, rng);
+    vector<double> interleaved(8 * count);
+    for (size_t g = 0; g < count; g++) {
+        for (int s = 0; s < 8; s++) {
+            interleaved[g * 8 + s % 4 * 2 + s / 4] = streams[s * count + g];
+        }
+    }
+    
+    BatchOutput2x2 expected(count);
+    size_t expected_degenerate = solveBatch2x2(games, expected.results(), BatchKernel::Scalar);
+    for (BatchKernel kernel : {BatchKernel::Scalar, BatchKernel::AVX2, BatchKernel::AVX512}) {
+        string name = batchKernelName(kernel);
+        BatchOutput2x2 planar(count);
+        BatchOutput2x2 packed(count);
+        if (solveBatch2x2(games, planar.results(), kernel) != expected_degenerate ||
+            !sameBatchOutput(planar, expected)) {
+            return fail("batch_kernels", "the " + name + " kernel differs from the scalar kernel");
+        }
+        if (solveBatch2x2Interleaved(interleaved.data(), count, packed.results(), kernel) != expected_degenerate ||
+            !sameBatchOutput(packed, expected)) {
+            return fail("batch_kernels", "the " + name + " kernel differs from the scalar kernel on interleaved games");
+        }
+    }
+    return true;
+}
+
+// The work-stealing pool runs every chunk exactly once, and the parallel
+// batch driver gives the serial results and totals whatever the chunk size
+// and thread count, on a reused pool and on a temporary one
+bool checkParallelBatch() {
+    WorkStealingPool pool(4);
+    for (size_t num_chunks : {0, 1, 3, 10007}) {
+        vector<atomic<int>> runs(num_chunks);
+        for (auto& r : runs) {
+            r = 0;
+        }
+        atomic<bool> bad_worker(false);
+        pool.run(num_chunks, [&](size_t chunk, int worker) {
+            runs[chunk]++;
+            if (worker < 0 || worker >= pool.threadCount()) {
+                bad_worker = true;
+            }
+        });
+        for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+            if (runs[chunk] != 1) {
+                return fail("parallel_batch", "chunk " + to_string(chunk) + " ran " + to_string(runs[chunk]) + " times");
+            }
+        }
+        if (bad_worker) {
+            return fail("parallel_batch", "a chunk ran on a worker outside the pool");
+        }
+    }
+    
+    mt19937_64 rng(16);
+    const size_t count = 50001;
+    vector<double> streams;
+    BatchGames2x2 games = randomBatch2x2(streams, count, rng);
+    BatchOutput2x2 expected(count);
+    size_t expected_degenerate = solveBatch2x2(games, expected.results());
+    size_t expected_mixed = 0;
+    for (uint8_t flags : expected.flags) {
+        expected_mixed += (flags & BATCH_HAS_MIXED) != 0;
+    }
+    
+    for (size_t chunk_size : {1, 7, 4096, 100000}) {
+        for (int temporary = 0; temporary < 2; temporary++) {
+            ParallelBatchOptions options(3, chunk_size);
+            ParallelBatchStats stats;
+            BatchOutput2x2 out(count);
+            size_t degenerate = temporary ? solveBatch2x2Parallel(games, out.results(), options, &stats)
+                                          : solveBatch2x2Parallel(games, out.results(), pool, options, &stats);
+            string where = " with chunks of " + to_string(chunk_size);
+            if (!sameBatchOutput(out, expected)) {
+                return fail("parallel_batch", "results differ from a serial solve" + where);
+            }
+            if (degenerate != expected_degenerate || stats.degenerate != expected_degenerate ||
+                stats.with_mixed != expected_mixed || stats.chunks != (count + chunk_size - 1) / chunk_size ||
+                stats.threads != (temporary ? 3 : 4)) {
+                return fail("parallel_batch", "totals differ from a serial solve" + where);
+            }
+        }
+    }
+    return true;
+}
+
+// SolverStats adds up and serializes every counter and phase. The counts of
+// known runs are exact when instrumentation is compiled in, zero when it is
+// compiled out, and kept per thread.
+bool checkSolverStats() {
+    SolverStats one;
+    one.counters[(size_t)SolverCounter::GridPoints] = 3;
+    one.phase_calls[(size_t)SolverPhase::Voting] = 2;
+    one.phase_nanoseconds[(size_t)SolverPhase::Voting] = 500000000;
+    SolverStats sum;
+    sum += one;
+    sum += one;
+    if (sum.count(SolverCounter::GridPoints) != 6 || sum.calls(SolverPhase::Voting) != 4 ||
+        sum.seconds(SolverPhase::Voting) != 1.0 || sum.count(SolverCounter::PayoffEvaluations) != 0) {
+        return fail("solver_stats", "SolverStats does not add up");
+    }
+    string json = solverStatsToJson(sum);
+    string enabled = GAMESOLVER_ENABLE_STATS ? "{\"enabled\": true," : "{\"enabled\": false,";
+    for (const string& part : {enabled, string("\"grid_points\": 6"), string("\"voting\": {\"calls\": 4, \"seconds\": 1}"),
+                               string("\"subgames_solved\": 0"), string("\"pure_nash\": {\"calls\": 0")}) {
+        if (json.find(part) == string::npos) {
+            return fail("solver_stats", "JSON lacks " + part + ": " + json);
+        }
+    }
+    
+    // Matching pennies: no dominance shortcut, so the grid search runs its 101 points
+    Game2x2 pennies;
+    const double payoffs[8] = {1, -1, -1, 1, -1, 1, 1, -1};
+    copy(payoffs, payoffs + 8, pennies.payoffs.begin());
+    uint64_t scale = GAMESOLVER_ENABLE_STATS ? 1 : 0;
+    NormalFormSolver solver(pennies);
+    SolverStats& stats = threadSolverStats();
+    stats.reset();
+    solver.findAllNashEquilibria(SolverMode::Grid);
+    if (stats.count(SolverCounter::GridPoints) != 101 * scale || stats.calls(SolverPhase::PureNash) != scale ||
+        stats.calls(SolverPhase::MixedNash) != scale ||
+        stats.count(SolverCounter::PayoffEvaluations) < 202 * scale) {
+        return fail("solver_stats", "unexpected counts for a grid solve: " + solverStatsToJson(stats));
+    }
+    
+    // Each 3x3 subgame is solved once per solver, however often it is analyzed
+    mt19937_64 rng(17);
+    Game3x3 game;
+    randomRealPayoffs(game, rng);
+    Game3x3Solver subgames(game);
+    stats.reset();
+    subgames.analyzeAll2x2Submatrices();
+    subgames.analyzeAll2x2Submatrices();
+    if (stats.count(SolverCounter::SubgamesSolved) != 9 * scale) {
+        return fail("solver_stats", "unexpected subgame count: " + solverStatsToJson(stats));
+    }
+    
+    // Another thread's work lands in that thread's stats
+    stats.reset();
+    uint64_t other_points = 0;
+    thread other([&solver, &other_points]() {
+        solver.findAllNashEquilibria(SolverMode::Grid);
+        other_points = threadSolverStats().count(SolverCounter::GridPoints);
+    });
+    other.join();
+    if (other_points != 101 * scale || stats.count(SolverCounter::GridPoints) != 0) {
+        return fail("solver_stats", "stats are not kept per thread");
+    }
+    return true;
+}
+
+// Iterated elimination by brute force: in alternating passes, remove every
+// live strategy that some other live strategy dominates on the opponent's
+// live strategies, until a row pass and a column pass change nothing
+static void naiveElimination(const DynamicGame& game, bool weak, vector<bool>& live_rows, vector<bool>& live_cols) {
+    live_rows.assign(game.rows(), true);
+    live_cols.assign(game.cols(), true);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int player = 0; player < 2; player++) {
+            vector<bool>& own = player == 0 ? live_rows : live_cols;
+            const vector<bool>& other = player == 0 ? live_cols : live_rows;
+            auto payoff = [&game, player](int mine, int theirs) {
+                return player == 0 ? game.getPayoff(mine, theirs, 0) : game.getPayoff(theirs, mine, 1);
+            };
+            vector<bool> dominated(own.size(), false);
+            for (int i = 0; i < (int)own.size(); i++) {
+                for (int k = 0; k < (int)own.size() && own[i] && !dominated[i]; k++) {
+                    if (k == i || !own[k]) {
+                        continue;
+                    }
+                    bool at_least = true;
+                    bool better = false;
+                    for (int j = 0; j < (int)other.size(); j++) {
+                        if (other[j]) {
+                            at_least = at_least && (weak ? payoff(k, j) >= payoff(i, j) : payoff(k, j) > payoff(i, j));
+                            better = better || payoff(k, j) > payoff(i, j);
+                        }
+                    }
+                    dominated[i] = at_least && (!weak || better);
+                }
+            }
+            for (int i = 0; i < (int)own.size(); i++) {
+                if (dominated[i]) {
+                    own[i] = false;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+// eliminateDominatedStrategies matches brute-force elimination in both modes,
+// on games with graded strategies so that much is eliminated, including games
+// wider than one mask word, and reducedGame keeps the surviving payoffs
+bool checkDominance() {
+    mt19937_64 rng(18);
+    uniform_int_distribution<int> size(1, 90);
+    uniform_int_distribution<int> spread(0, 12);
+    for (int trial = 0; trial < 400; trial++) {
+        DynamicGame game(size(rng), size(rng));
+        // A strategy's payoffs are its grade plus noise, so wide gaps in grade dominate
+        uniform_int_distribution<int> noise(0, spread(rng));
+        uniform_int_distribution<int> grade(0, 40);
+        vector<int> row_grade(game.rows()), col_grade(game.cols());
+        for (int& g : row_grade) {
+            g = grade(rng);
+        }
+        for (int& g : col_grade) {
+            g = grade(rng);
+        }
+        for (int i = 0; i < game.rows(); i++) {
+            for (int j = 0; j < game.cols(); j++) {
+                game.setPayoff(i, j, 0, row_grade[i] + noise(rng));
+                game.setPayoff(i, j, 1, col_grade[j] + noise(rng));
+            }
+        }
+        
+        for (DominanceMode mode : {DominanceMode::None, DominanceMode::Strict, DominanceMode::Weak}) {
+            vector<bool> live_rows, live_cols;
+            naiveElimination(game, mode == DominanceMode::Weak, live_rows, live_cols);
+            if (mode == DominanceMode::None) {
+                live_rows.assign(game.rows(), true);
+                live_cols.assign(game.cols(), true);
+            }
+            DominanceReduction reduction = eliminateDominatedStrategies(game, mode);
+            vector<int> row_map, col_map;
+            for (int i = 0; i < game.rows(); i++) {
+                if (live_rows[i]) {
+                    row_map.push_back(i);
+                }
+                if (reduction.live_rows.test(i) != live_rows[i]) {
+                    return fail("dominance", "row " + to_string(i) + " differs from brute-force elimination");
+                }
+            }
+            for (int j = 0; j < game.cols(); j++) {
+                if (live_cols[j]) {
+                    col_map.push_back(j);
+                }
+                if (reduction.live_cols.test(j) != live_cols[j]) {
+                    return fail("dominance", "column " + to_string(j) + " differs from brute-force elimination");
+                }
+            }
+            if (reduction.row_map != row_map || reduction.col_map != col_map ||
+                reduction.reduced() != (row_map.size() < (size_t)game.rows() || col_map.size() < (size_t)game.cols())) {
+                return fail("dominance", "the index maps differ from the surviving strategies");
+            }
+            
+            DynamicGame reduced = reducedGame(game, reduction);
+            for (int i = 0; i < reduced.rows(); i++) {
+                for (int j = 0; j < reduced.cols(); j++) {
+                    for (int k = 0; k < 2; k++) {
+                        if (reduced.getPayoff(i, j, k) != game.getPayoff(row_map[i], col_map[j], k)) {
+                            return fail("dominance", "reducedGame moved a payoff");
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// SolverMode::Adaptive matches Analytic on random real and small-integer 2x2
+// games, for Nash and non-myopic equilibria. findSignRuns partitions [0, 1] at
+// the roots of a quadratic and a zero function, and a linear function costs
+// logarithmically many evaluations.
+bool checkAdaptiveMode() {
+    mt19937_64 rng(19);
+    for (int trial = 0; trial < 5000; trial++) {
+        Game2x2 game;
+        if (trial % 2) {
+            randomPayoffs(game, rng, -3, 3);
+        } else {
+            randomRealPayoffs(game, rng);
+        }
+        NormalFormSolver solver(game);
+        if (!sameEquilibria(solver.findAllNashEquilibria(SolverMode::Adaptive), solver.findAllNashEquilibria())) {
+            return fail("adaptive_mode", "Adaptive Nash equilibria differ from Analytic in trial " + to_string(trial));
+        }
+        if (!sameEquilibria(solver.findNonMyopicEquilibria(SolverMode::Adaptive), solver.findNonMyopicEquilibria())) {
+            return fail("adaptive_mode", "Adaptive non-myopic equilibria differ from Analytic in trial " + to_string(trial));
+        }
+    }
+    
+    vector<SignRun> quadratic = findSignRuns([](double x) { return (x - 0.3) * (x - 0.7); });
+    const SignRun expected[5] = {{0.0, 0.3, 1}, {0.3, 0.3, 0}, {0.3, 0.7, -1}, {0.7, 0.7, 0}, {0.7, 1.0, 1}};
+    bool same = quadratic.size() == 5;
+    for (size_t r = 0; same && r < 5; r++) {
+        same = quadratic[r].sign == expected[r].sign && fabs(quadratic[r].lo - expected[r].lo) < 1e-9 &&
+               fabs(quadratic[r].hi - expected[r].hi) < 1e-9;
+    }
+    if (!same) {
+        return fail("adaptive_mode", "wrong sign runs for (x - 0.3)(x - 0.7)");
+    }
+    vector<SignRun> zero = findSignRuns([](double) { return 0.0; });
+    if (zero.size() != 1 || zero[0].sign != 0 || zero[0].lo != 0.0 || zero[0].hi != 1.0) {
+        return fail("adaptive_mode", "wrong sign runs for the zero function");
+    }
+    
+    // 17 coarse points and about 30 bisections, not the 10^9 of a uniform grid
+    int evaluations = 0;
+    vector<SignRun> linear = findSignRuns([&evaluations](double x) {
+        evaluations++;
+        return x - 1.0 / 3.0;
+    });
+    if (linear.size() != 3 || fabs(linear[1].lo - 1.0 / 3.0) > 1e-9 || evaluations > 60) {
+        return fail("adaptive_mode", "linear root found in " + to_string(evaluations) + " evaluations");
+    }
+    return true;
+}
+
+// Run a text batch over input on two threads and return its output
+static string runBatch(const string& input, int payoffs_per_game, const vector<string>& columns,
+                       TextBatchSolveFn solve, size_t& bad_lines) {
+    FILE* in = tmpfile();
+    FILE* out = tmpfile();
+    fwrite(input.data(), 1, input.size(), in);
+    rewind(in);
+    bad_lines = 0;
+    runTextBatch(in, out, TextBatchOptions(payoffs_per_game, ',', 2, 2), columns, solve, &bad_lines);
+    rewind(out);
+    string output;
+    char buffer[4096];
+    for (size_t n; (n = fread(buffer, 1, sizeof(buffer), out)) > 0;) {
+        output.append(buffer, n);
+    }
+    fclose(in);
+    fclose(out);
+    return output;
+}
+
+// Batch output of game_2x2_solver on known games: pure equilibria as
+// probabilities of strategy 1, and non-finite payoffs rejected as malformed
+bool checkBatch2x2() {
+    const string input =
+        "# Prisoner's Dilemma, matching pennies\n"
+        "3,3,0,5,5,0,1,1\n"
+        "1 -1 -1 1 -1 1 1 -1\n"
+        "\n"
+        "inf,1,1,1,1,1,1,1\n"
+        "1e400,1,1,1,1,1,1,1\n"
+        "nan,1,1,1,1,1,1,1\n"
+        "1,2,3\n";
+    const string expected =
+        "line,nash,non_myopic\n"
+        "2,0/0,0/0\n"
+        "3,0.5/0.5,0.5/0.5\n"
+        "5,error\n"
+        "6,error\n"
+        "7,error\n"
+        "8,error\n";
+    size_t bad_lines;
+    string output = runBatch(input, 8, {"nash", "non_myopic"}, solveBatchLine2x2, bad_lines);
+    if (output != expected) {
+        return fail("batch_2x2", "unexpected output:\n" + output);
+    }
+    if (bad_lines != 4) {
+        return fail("batch_2x2", to_string(bad_lines) + " malformed lines instead of 4");
+    }
+    return true;
+}
+
+// Game files round-trip: games written through either write overload, including
+// a non-const payoff pointer, map back unchanged and a game of other dimensions
+// is refused. Solving a 2x2 file of either layout gives solveGame2x2's results.
+bool checkGameFile() {
+    mt19937_64 rng(12);
+    const string games_path = "check_game_file.games";
+    const string planar_path = "check_game_file.planar";
+    const string results_path = "check_game_file.results";
+    
+    vector<DynamicGame> games;
+    GameFileWriter writer;
+    if (!writer.open(games_path, 3, 4, 16)) {
+        return fail("game_file", writer.lastError());
+    }
+    for (int trial = 0; trial < 100; trial++) {
+        DynamicGame game(3, 4);
+        randomRealPayoffs(game, rng);
+        double* payoffs = game.payoffs.data();
+        if (!(trial % 2 == 0 ? writer.write(game) : writer.write(payoffs))) {
+            return fail("game_file", writer.lastError());
+        }
+        games.push_back(game);
+    }
+    if (writer.write(DynamicGame(4, 3)) || writer.gamesWritten() != games.size()) {
+        return fail("game_file", "a 4x3 game was written to a file of 3x4 games");
+    }
+    if (!writer.close()) {
+        return fail("game_file", writer.lastError());
+    }
+    
+    MappedGameFile file;
+    if (!file.open(games_path)) {
+        return fail("game_file", file.lastError());
+    }
+    if (file.rows() != 3 || file.cols() != 4 || file.count() != games.size()) {
+        return fail("game_file", "header does not match the games written");
+    }
+    for (size_t g = 0; g < games.size(); g++) {
+        GameView view = file.game(g);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 4; j++) {
+                for (int k = 0; k < 2; k++) {
+                    if (view.getPayoffUnchecked(i, j, k) != games[g].getPayoffUnchecked(i, j, k)) {
+                        return fail("game_file", "game " + to_string(g) + " reads back changed");
+                    }
+                }
+            }
+        }
+    }
+    file.close();
+    
+    // 2x2 games with ties, so some are degenerate, in both layouts
+    const size_t count = 1000;
+    vector<double> streams(8 * count);
+    if (!writer.open(games_path, 2, 2, 64)) {
+        return fail("game_file", writer.lastError());
+    }
+    for (size_t g = 0; g < count; g++) {
+        Game2x2 game;
+        randomPayoffs(game, rng, -2, 2);
+        for (int s = 0; s < 8; s++) {
+            streams[s * count + g] = game.payoffs[s % 4 * 2 + s / 4];
+        }
+        writer.write(game);
+    }
+    const double* data = streams.data();
+    BatchGames2x2 planar = {data, data + count, data + 2 * count, data + 3 * count, data + 4 * count,
+                            data + 5 * count, data + 6 * count, data + 7 * count, count};
+    string error;
+    if (!writer.close() || !writePlanarGameFile(planar_path, planar, &error)) {
+        return fail("game_file", "cannot write the 2x2 files " + writer.lastError() + error);
+    }
+    
+    for (const string& path : {games_path, planar_path}) {
+        size_t degenerate = 0;
+        if (!solveGameFile2x2(path, results_path, &degenerate, &error)) {
+            return fail("game_file", error);
+        }
+        ifstream in(results_path, ios::binary);
+        GameFileHeader hdr;
+        vector<ResultRecord2x2> records(count);
+        in.read((char*)&hdr, sizeof(hdr));
+        in.read((char*)records.data(), count * sizeof(ResultRecord2x2));
+        if (!in || memcmp(hdr.magic, RESULT_FILE_MAGIC, sizeof(hdr.magic)) != 0 || hdr.count != count) {
+            return fail("game_file", "cannot read back the results of " + path);
+        }
+        size_t expected_degenerate = 0;
+        for (size_t g = 0; g < count; g++) {
+            Solution2x2 expected = solveGame2x2(planar.a00[g], planar.a01[g], planar.a10[g], planar.a11[g],
+                                                planar.b00[g], planar.b01[g], planar.b10[g], planar.b11[g]);
+            const ResultRecord2x2& record = records[g];
+            expected_degenerate += (expected.flags & BATCH_DEGENERATE) != 0;
+            bool same_mixed = (isnan(expected.mixed_p1) && isnan(record.mixed_p1)) ||
+                              (near(expected.mixed_p1, record.mixed_p1) && near(expected.mixed_p2, record.mixed_p2));
+            if (record.pure_mask != expected.pure_mask || record.num_equilibria != expected.num_equilibria ||
+                record.flags != expected.flags || !same_mixed) {
+                return fail("game_file", "result " + to_string(g) + " of " + path + " differs from solveGame2x2");
+            }
+        }
+        if (degenerate != expected_degenerate) {
+            return fail("game_file", "wrong degenerate count for " + path);
+        }
+    }
+    remove(games_path.c_str());
+    remove(planar_path.c_str());
+    remove(results_path.c_str());
+    return true;
+}
+
+struct Check {
+    const char* name;
+    bool (*run)();
+};
+
+int main(int argc, char** argv) {
+    const Check checks[] = {
+        {"set_payoff_bounds", checkSetPayoffBounds},
+        {"session", checkSession},
+        {"non_myopic", checkNonMyopic},
+        {"solve_cached", checkSolveCached},
+        {"exact_mode", checkExactMode},
+        {"rational", checkRational},
+        {"nash_engine", checkNashEngine},
+        {"canonical_cache", checkCanonicalCache},
+        {"sweep", checkSweep},
+        {"nplayer", checkNPlayer},
+        {"pure_screen", checkPureScreen},
+        {"compressed", checkCompressed},
+        {"batch_solver", checkBatchSolver},
+        {"batch_kernels", checkBatchKernels},
+        {"parallel_batch", checkParallelBatch},
+        {"batch_2x2", checkBatch2x2},
+        {"game_file", checkGameFile},
+        {"solver_stats", checkSolverStats},
+        {"dominance", checkDominance},
+        {"adaptive_mode", checkAdaptiveMode},
+    };
+    
+    int failures = 0;
+    int run = 0;
+    for (const Check& check : checks) {
+        bool selected = argc < 2;
+        for (int a = 1; a < argc; a++) {
+            selected = selected || strcmp(argv[a], check.name) == 0;
+        }
+        if (!selected) {
+            continue;
+        }
+        run++;
+        if (check.run()) {
+            cout << check.name << ": ok" << endl;
+        } else {
+            failures++;
+        }
+    }
+    if (run == 0) {
+        cout << "No check matches the given names" << endl;
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -1,45 +1,72 @@
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <iomanip>
-#include "main.cpp" // Include the main solver
+#include "game_solver.h"
+#include "game_report.h"
 
 using namespace std;
 
-void testGame(const string& name, const Game2x2& game) {
+// An equilibrium a game is known to have. Pure Nash equilibria give the
+// strategy indices, the others the probabilities of strategy 1.
+struct KnownEquilibrium {
+    EquilibriumKind kind;
+    double p1;
+    double p2;
+};
+
+// Whether the solver found exactly the known equilibria, in order
+bool matchesKnown(const vector<Equilibrium>& found, const vector<KnownEquilibrium>& known) {
+    if (found.size() != known.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < found.size(); k++) {
+        if (found[k].kind != known[k].kind || found[k].isContinuum ||
+            fabs(found[k].profile.p1_strategy1_prob - known[k].p1) > 1e-9 ||
+            fabs(found[k].profile.p2_strategy1_prob - known[k].p2) > 1e-9) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Print a game and its equilibria; returns false if they are not the known ones
+bool testGame(const string& name, const Game2x2& game, const vector<KnownEquilibrium>& known_nash,
+              const vector<KnownEquilibrium>& known_non_myopic) {
     cout << "\n" << string(60, '=') << endl;
     cout << "Testing: " << name << endl;
     cout << string(60, '=') << endl;
     
     NormalFormSolver solver(game);
-    solver.printGame();
+    GameReporter reporter(cout);
+    reporter.printGame(solver.getGame());
     
     // Find Nash equilibria
     vector<Equilibrium> nash_equilibria = solver.findAllNashEquilibria();
-    cout << "Nash Equilibria:" << endl;
-    if (nash_equilibria.empty()) {
-        cout << "No Nash equilibria found." << endl;
-    } else {
-        for (const auto& eq : nash_equilibria) {
-            cout << "- " << eq.description << endl;
-        }
-    }
+    reporter.printEquilibria("Nash Equilibria:", nash_equilibria, "No Nash equilibria found.");
     
     // Find non-myopic equilibria
     vector<Equilibrium> non_myopic_equilibria = solver.findNonMyopicEquilibria();
-    cout << "\nNon-Myopic Equilibria:" << endl;
-    if (non_myopic_equilibria.empty()) {
-        cout << "No non-myopic equilibria found." << endl;
-    } else {
-        for (const auto& eq : non_myopic_equilibria) {
-            cout << "- " << eq.description << endl;
-        }
-    }
     cout << endl;
+    reporter.printEquilibria("Non-Myopic Equilibria:", non_myopic_equilibria, "No non-myopic equilibria found.");
+    cout << endl;
+    
+    bool ok = true;
+    if (!matchesKnown(nash_equilibria, known_nash)) {
+        cout << "FAILED: " << name << " Nash equilibria differ from the known ones" << endl;
+        ok = false;
+    }
+    if (!matchesKnown(non_myopic_equilibria, known_non_myopic)) {
+        cout << "FAILED: " << name << " non-myopic equilibria differ from the known ones" << endl;
+        ok = false;
+    }
+    return ok;
 }
 
 int main() {
     cout << "=== Testing Different Game Types ===" << endl;
+    bool ok = true;
     
     // 1. Prisoner's Dilemma
     Game2x2 prisoner_dilemma;
@@ -52,7 +79,9 @@ int main() {
     prisoner_dilemma.setPayoff(1, 1, 0, 1.0); // Both defect
     prisoner_dilemma.setPayoff(1, 1, 1, 1.0);
     
-    testGame("Prisoner's Dilemma", prisoner_dilemma);
+    // Defecting is dominant for both
+    ok &= testGame("Prisoner's Dilemma", prisoner_dilemma, {{EquilibriumKind::PureNash, 1, 1}},
+                   {{EquilibriumKind::NonMyopic, 0.0, 0.0}});
     
     // 2. Battle of the Sexes
     Game2x2 battle_of_sexes;
@@ -65,7 +94,10 @@ int main() {
     battle_of_sexes.setPayoff(1, 1, 0, 2.0); // Both prefer same activity
     battle_of_sexes.setPayoff(1, 1, 1, 3.0);
     
-    testGame("Battle of the Sexes", battle_of_sexes);
+    ok &= testGame("Battle of the Sexes", battle_of_sexes,
+                   {{EquilibriumKind::PureNash, 0, 0}, {EquilibriumKind::PureNash, 1, 1},
+                    {EquilibriumKind::MixedNash, 0.6, 0.4}},
+                   {{EquilibriumKind::NonMyopic, 1.0, 0.0}});
     
     // 3. Coordination Game
     Game2x2 coordination;
@@ -78,7 +110,10 @@ int main() {
     coordination.setPayoff(1, 1, 0, 1.0); // Both choose B
     coordination.setPayoff(1, 1, 1, 1.0);
     
-    testGame("Coordination Game", coordination);
+    ok &= testGame("Coordination Game", coordination,
+                   {{EquilibriumKind::PureNash, 0, 0}, {EquilibriumKind::PureNash, 1, 1},
+                    {EquilibriumKind::MixedNash, 1.0 / 3.0, 1.0 / 3.0}},
+                   {{EquilibriumKind::NonMyopic, 1.0, 1.0}});
     
     // 4. Matching Pennies
     Game2x2 matching_pennies;
@@ -91,7 +126,9 @@ int main() {
     matching_pennies.setPayoff(1, 1, 0, 1.0); // Same choice
     matching_pennies.setPayoff(1, 1, 1, -1.0);
     
-    testGame("Matching Pennies", matching_pennies);
+    // Only the uniform mix leaves each player indifferent
+    ok &= testGame("Matching Pennies", matching_pennies, {{EquilibriumKind::MixedNash, 0.5, 0.5}},
+                   {{EquilibriumKind::NonMyopic, 0.5, 0.5}});
     
-    return 0;
+    return ok ? 0 : 1;
 }
@@ -0,0 +1,508 @@
+#include "text_batch.h"
+#include "parallel_batch.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+// Powers of ten that are exact doubles
+static const double exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Parse a number starting at p, advancing p past it
+bool parseDouble(const char*& p, const char* end, double& value) {
+    const char* s = p;
+    bool negative = false;
+    if (s < end && (*s == '+' || *s == '-')) {
+        negative = *s == '-';
+        s++;
+    }
+    
+    uint64_t mantissa = 0;
+    int significant = 0; // Significant digits accumulated in mantissa
+    int exponent = 0;
+    bool any_digit = false;
+    for (; s < end && isDigit(*s); s++) {
+        any_digit = true;
+        if (mantissa != 0 || *s != '0') {
+            significant++;
+        }
+        if (significant <= 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*s - '0');
+        } else {
+            exponent++;
+        }
+    }
+    if (s < end && *s == '.') {
+        for (s++; s < end && isDigit(*s); s++) {
+            any_digit = true;
+            if (mantissa != 0 || *s != '0') {
+                significant++;
+            }
+            if (significant <= 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*s - '0');
+                exponent--;
+            }
+        }
+    }
+    if (any_digit && s < end && (*s == 'e' || *s == 'E')) {
+        const char* e = s + 1;
+        bool negative_exponent = false;
+        if (e < end && (*e == '+' || *e == '-')) {
+            negative_exponent = *e == '-';
+            e++;
+        }
+        if (e < end && isDigit(*e)) {
+            int value_exponent = 0;
+            for (; e < end && isDigit(*e); e++) {
+                value_exponent = min(value_exponent * 10 + (*e - '0'), 100000);
+            }
+            exponent += negative_exponent ? -value_exponent : value_exponent;
+            s = e;
+        }
+    }
+    
+    // Exact when the mantissa and the power of ten are both exact doubles
+    if (any_digit && significant <= 15 && exponent >= -22 && exponent <= 22) {
+        double result = (double)mantissa;
+        result = exponent < 0 ? result / exact_powers_of_ten[-exponent] : result * exact_powers_of_ten[exponent];
+        value = negative ? -result : result;
+        p = s;
+        return true;
+    }
+    
+    // Long or extreme tokens go through strtod
+    char token[128];
+    size_t length = 0;
+    for (const char* t = p; t < end && length + 1 < sizeof(token); t++, length++) {
+        char c = *t;
+        if (c == ',' || c == '\t' || c == ';' || c == ' ' || c == '\n' || c == '\r') {
+            break;
+        }
+        token[length] = c;
+    }
+    token[length] = '\0';
+    char* token_end = nullptr;
+    double result = strtod(token, &token_end);
+    if (token_end == token || !isfinite(result)) {
+        return false;
+    }
+    value = result;
+    p += token_end - token;
+    return true;
+}
+
+OutputBuffer::OutputBuffer(FILE* f, size_t capacity) : file(f), data(max<size_t>(64, capacity)), used(0) {}
+
+void OutputBuffer::flush() {
+    if (file && used > 0) {
+        fwrite(data.data(), 1, used, file);
+        used = 0;
+    }
+}
+
+// Flush to the FILE, or grow an in-memory buffer
+void OutputBuffer::makeRoom() {
+    if (file) {
+        flush();
+    } else {
+        data.resize(data.size() * 2);
+    }
+}
+
+void OutputBuffer::append(const char* s) {
+    for (; *s; s++) {
+        put(*s);
+    }
+}
+
+void OutputBuffer::append(const char* s, size_t length) {
+    if (file && length >= data.size()) {
+        flush();
+        fwrite(s, 1, length, file);
+        return;
+    }
+    while (data.size() - used < length) {
+        makeRoom();
+    }
+    memcpy(data.data() + used, s, length);
+    used += length;
+}
+
+// Unsigned integer in decimal
+void OutputBuffer::appendUnsigned(uint64_t value) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (n > 0) {
+        put(digits[--n]);
+    }
+}
+
+// Probability in [0, 1] with up to 6 decimals
+void OutputBuffer::appendProbability(double p) {
+    if (!(p >= 0.0 && p <= 1.0)) {
+        append("nan");
+        return;
+    }
+    uint64_t micros = (uint64_t)(p * 1e6 + 0.5);
+    if (micros == 0) {
+        put('0');
+        return;
+    }
+    if (micros >= 1000000) {
+        put('1');
+        return;
+    }
+    char fraction[6];
+    int length = 6;
+    for (int i = 5; i >= 0; i--) {
+        fraction[i] = (char)('0' + micros % 10);
+        micros /= 10;
+    }
+    while (fraction[length - 1] == '0') {
+        length--;
+    }
+    put('0');
+    put('.');
+    for (int i = 0; i < length; i++) {
+        put(fraction[i]);
+    }
+}
+
+// Probability range: "p" if lo == hi, otherwise "lo..hi"
+void OutputBuffer::appendProbabilityRange(double lo, double hi) {
+    appendProbability(lo);
+    if (lo != hi) {
+        append("..");
+        appendProbability(hi);
+    }
+}
+
+// Block of parsed lines passed from the reader thread to the solver
+struct TextBlock {
+    vector<double> payoffs;         // payoffs_per_game values per line
+    vector<uint64_t> line_numbers;  // Input line of each game
+    vector<uint8_t> valid;          // 0 for a malformed line
+    size_t count;
+};
+
+// Bounded blocking queue of blocks
+class TextBlockQueue {
+private:
+    mutex mtx;
+    condition_variable cv;
+    deque<TextBlock*> blocks;
+    bool closed;
+
+public:
+    TextBlockQueue() : closed(false) {}
+    
+    void push(TextBlock* block) {
+        {
+            lock_guard<mutex> lock(mtx);
+            blocks.push_back(block);
+        }
+        cv.notify_one();
+    }
+    
+    // Next block, or nullptr once the queue is closed and drained
+    TextBlock* pop() {
+        unique_lock<mutex> lock(mtx);
+        cv.wait(lock, [&] { return closed || !blocks.empty(); });
+        if (blocks.empty()) {
+            return nullptr;
+        }
+        TextBlock* block = blocks.front();
+        blocks.pop_front();
+        return block;
+    }
+    
+    void close() {
+        {
+            lock_guard<mutex> lock(mtx);
+            closed = true;
+        }
+        cv.notify_all();
+    }
+};
+
+static bool isSeparator(char c) {
+    return c == ',' || c == '\t' || c == ';' || c == ' ';
+}
+
+// True if [p, end) contains a letter, as a header line does
+static bool hasLetter(const char* p, const char* end) {
+    for (; p < end; p++) {
+        if ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Parse the numbers of one line into payoffs; true if there are exactly `expected`
+static bool parseLine(const char* p, const char* end, double* payoffs, int expected) {
+    int n = 0;
+    while (true) {
+        while (p < end && isSeparator(*p)) {
+            p++;
+        }
+        if (p == end) {
+            return n == expected;
+        }
+        double value;
+        if (n == expected || !parseDouble(p, end, value)) {
+            return false;
+        }
+        payoffs[n++] = value;
+        if (p < end && !isSeparator(*p)) {
+            return false;
+        }
+    }
+}
+
+// Reader thread: split the input into lines and parse them into blocks.
+// Blocks cycle between free_blocks and full_blocks, so none are allocated here.
+static void readTextBlocks(FILE* in, const TextBatchOptions& options,
+                           TextBlockQueue& free_blocks, TextBlockQueue& full_blocks) {
+    const int width = options.payoffs_per_game;
+    vector<char> buffer(1 << 22);
+    size_t carry = 0;
+    uint64_t line_number = 0;
+    bool first_content_line = true;
+    bool eof = false;
+    
+    TextBlock* block = free_blocks.pop();
+    block->count = 0;
+    while (!eof) {
+        size_t requested = buffer.size() - carry;
+        size_t n = fread(buffer.data() + carry, 1, requested, in);
+        eof = n < requested;
+        
+        const char* p = buffer.data();
+        const char* end = p + carry + n;
+        while (p < end) {
+            const char* newline = (const char*)memchr(p, '\n', end - p);
+            if (!newline && !eof) {
+                break;
+            }
+            const char* line_end = newline ? newline : end;
+            line_number++;
+            
+            const char* content = p;
+            while (content < line_end && (*content == ' ' || *content == '\t')) {
+                content++;
+            }
+            const char* trimmed_end = line_end;
+            if (trimmed_end > content && trimmed_end[-1] == '\r') {
+                trimmed_end--;
+            }
+            p = newline ? newline + 1 : end;
+            if (content == trimmed_end || *content == '#') {
+                continue;
+            }
+            
+            double* payoffs = block->payoffs.data() + block->count * width;
+            bool valid = parseLine(content, trimmed_end, payoffs, width);
+            bool header = first_content_line && !valid && hasLetter(content, trimmed_end);
+            first_content_line = false;
+            if (header) {
+                continue;
+            }
+            block->line_numbers[block->count] = line_number;
+            block->valid[block->count] = valid;
+            block->count++;
+            
+            if (block->count == options.block_lines) {
+                full_blocks.push(block);
+                block = free_blocks.pop();
+                block->count = 0;
+            }
+        }
+        
+        // Keep the partial last line; grow the buffer for a line longer than it
+        carry = end - p;
+        memmove(buffer.data(), p, carry);
+        if (carry == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+    }
+    
+    if (block->count > 0) {
+        full_blocks.push(block);
+    } else {
+        free_blocks.push(block);
+    }
+    full_blocks.close();
+}
+
+// Solve one game per input line and write one result line per game
+size_t runTextBatch(FILE* in, FILE* out, const TextBatchOptions& options, const vector<string>& columns,
+                    TextBatchSolveFn solve, size_t* bad_lines) {
+    const int width = options.payoffs_per_game;
+    const char delimiter = options.delimiter;
+    TextBatchOptions block_options = options;
+    block_options.block_lines = max<size_t>(1, options.block_lines);
+    
+    // Enough blocks for the reader to run ahead of the solver
+    const int num_blocks = 4;
+    vector<unique_ptr<TextBlock>> storage;
+    TextBlockQueue free_blocks;
+    TextBlockQueue full_blocks;
+    for (int i = 0; i < num_blocks; i++) {
+        storage.emplace_back(new TextBlock);
+        TextBlock* block = storage.back().get();
+        block->payoffs.resize(block_options.block_lines * width);
+        block->line_numbers.resize(block_options.block_lines);
+        block->valid.resize(block_options.block_lines);
+        block->count = 0;
+        free_blocks.push(block);
+    }
+    
+    thread reader(readTextBlocks, in, cref(block_options), ref(free_blocks), ref(full_blocks));
+    
+    OutputBuffer output(out);
+    output.append("line");
+    for (const auto& column : columns) {
+        output.put(delimiter);
+        output.append(column.c_str());
+    }
+    output.put('\n');
+    
+    // Each block is cut into chunks solved in parallel into their own buffers,
+    // which are then written in input order
+    const size_t chunk_lines = 1024;
+    size_t num_chunks = (block_options.block_lines + chunk_lines - 1) / chunk_lines;
+    vector<unique_ptr<OutputBuffer>> chunk_output;
+    for (size_t c = 0; c < num_chunks; c++) {
+        chunk_output.emplace_back(new OutputBuffer(nullptr, 1 << 16));
+    }
+    vector<size_t> chunk_bad(num_chunks);
+    WorkStealingPool pool(options.num_threads);
+    
+    size_t games = 0;
+    size_t bad = 0;
+    while (TextBlock* block = full_blocks.pop()) {
+        size_t block_chunks = (block->count + chunk_lines - 1) / chunk_lines;
+        pool.run(block_chunks, [&](size_t chunk, int) {
+            OutputBuffer& text = *chunk_output[chunk];
+            text.clear();
+            chunk_bad[chunk] = 0;
+            size_t end = min(block->count, (chunk + 1) * chunk_lines);
+            for (size_t i = chunk * chunk_lines; i < end; i++) {
+                text.appendUnsigned(block->line_numbers[i]);
+                text.put(delimiter);
+                if (block->valid[i]) {
+                    solve(block->payoffs.data() + i * width, text, delimiter);
+                } else {
+                    text.append("error");
+                    chunk_bad[chunk]++;
+                }
+                text.put('\n');
+            }
+        });
+        for (size_t c = 0; c < block_chunks; c++) {
+            output.append(chunk_output[c]->bytes(), chunk_output[c]->size());
+            bad += chunk_bad[c];
+        }
+        games += block->count;
+        free_blocks.push(block);
+    }
+    reader.join();
+    output.flush();
+    fflush(out);
+    
+    if (bad_lines) {
+        *bad_lines = bad;
+    }
+    return games;
+}
+
+// Parse the batch options
+bool parseTextBatchArgs(int argc, char* argv[], TextBatchArgs& args) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--batch") {
+            args.enabled = true;
+            if (i + 1 < argc && (argv[i + 1][0] != '-' || strcmp(argv[i + 1], "-") == 0)) {
+                args.input = argv[++i];
+            }
+        } else if (arg == "--output" || arg == "-o") {
+            if (i + 1 >= argc) {
+                cerr << arg << " needs a file name" << endl;
+                return false;
+            }
+            args.output = argv[++i];
+        } else if (arg == "--tsv") {
+            args.delimiter = '\t';
+        } else if (arg == "--threads") {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+                cerr << arg << " needs a positive thread count" << endl;
+                return false;
+            }
+            args.num_threads = atoi(argv[++i]);
+        } else if (arg == "--cache") {
+            args.cache = true;
+        }
+    }
+    return true;
+}
+
+// Open the files named in args, run the batch and report a summary on stderr
+int runTextBatchCommand(const TextBatchArgs& args, int payoffs_per_game, const vector<string>& columns,
+                        TextBatchSolveFn solve) {
+    FILE* in = args.input == "-" ? stdin : fopen(args.input.c_str(), "rb");
+    if (!in) {
+        cerr << "Cannot open " << args.input << endl;
+        return 1;
+    }
+    FILE* out = args.output == "-" ? stdout : fopen(args.output.c_str(), "wb");
+    if (!out) {
+        cerr << "Cannot create " << args.output << endl;
+        if (in != stdin) {
+            fclose(in);
+        }
+        return 1;
+    }
+    
+    size_t bad_lines = 0;
+    size_t games = runTextBatch(in, out, TextBatchOptions(payoffs_per_game, args.delimiter, 16384, args.num_threads), columns, solve,
+                                &bad_lines);
+    bool read_failed = ferror(in) != 0;
+    bool write_failed = ferror(out) != 0;
+    if (in != stdin) {
+        fclose(in);
+    }
+    if (out != stdout) {
+        write_failed = fclose(out) != 0 || write_failed;
+    }
+    
+    cerr << "Solved " << (games - bad_lines) << " games";
+    if (bad_lines > 0) {
+        cerr << ", " << bad_lines << " malformed lines";
+    }
+    cerr << endl;
+    if (read_failed || write_failed) {
+        cerr << (read_failed ? "Read error" : "Write error") << endl;
+        return 1;
+    }
+    return bad_lines > 0 ? 2 : 0;
+}
@@ -0,0 +1,120 @@
+#ifndef TEXT_BATCH_H
+#define TEXT_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Parse a number starting at p (optional sign, digits, fraction, exponent),
+// advancing p past it. Numbers with at most 15 significant digits and a
+// small exponent are converted exactly without strtod; anything else falls
+// back to strtod. Returns false if no number starts at p or the number is not
+// finite (inf, nan, or out of range like 1e400), so such a payoff makes its
+// line malformed.
+bool parseDouble(const char*& p, const char* end, double& value);
+
+// Buffered writer for result lines; flushes to the FILE in large blocks.
+// Without a FILE it is a growable in-memory buffer.
+class OutputBuffer {
+private:
+    FILE* file;
+    vector<char> data;
+    size_t used;
+    
+    // Flush to the FILE, or grow an in-memory buffer
+    void makeRoom();
+
+public:
+    explicit OutputBuffer(FILE* f = nullptr, size_t capacity = 1 << 20);
+    ~OutputBuffer() { flush(); }
+    
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+    
+    // Write the buffered bytes to the FILE (no-op for an in-memory buffer)
+    void flush();
+    
+    // Buffered bytes and their count; clear() discards them
+    const char* bytes() const { return data.data(); }
+    size_t size() const { return used; }
+    void clear() { used = 0; }
+    
+    void put(char c) {
+        if (used == data.size()) {
+            makeRoom();
+        }
+        data[used++] = c;
+    }
+    
+    void append(const char* s);
+    void append(const char* s, size_t length);
+    
+    // Unsigned integer in decimal
+    void appendUnsigned(uint64_t value);
+    
+    // Probability in [0, 1] with up to 6 decimals ("0", "0.25", "0.333333", "1")
+    void appendProbability(double p);
+    
+    // Probability range: "p" if lo == hi, otherwise "lo..hi"
+    void appendProbabilityRange(double lo, double hi);
+};
+
+// Writes the result fields of one game, separated by delimiter (no game number, no newline)
+typedef void (*TextBatchSolveFn)(const double* payoffs, OutputBuffer& out, char delimiter);
+
+// Options of a text batch run
+struct TextBatchOptions {
+    int payoffs_per_game; // 8 for 2x2 games, 18 for 3x3 games
+    char delimiter;       // Output field separator
+    size_t block_lines;   // Games per pipeline block
+    int num_threads;      // Threads solving each block, 0 = hardware concurrency
+    
+    TextBatchOptions(int payoffs, char delim = ',', size_t block = 16384, int threads = 0)
+        : payoffs_per_game(payoffs), delimiter(delim), block_lines(block), num_threads(threads) {}
+};
+
+// Solve one game per input line and write one result line per game.
+// Input lines hold payoffs_per_game numbers in [row][col][player] order,
+// separated by commas, tabs, semicolons or spaces. Blank lines and lines
+// starting with '#' are skipped, and a first line that does not parse and
+// contains letters is taken as a header. Each output line is the input line
+// number followed by the fields written by solve, or by "error" for a
+// malformed line; the first output line names the columns ("line", then
+// `columns`). A reader thread parses blocks of lines while a pool of
+// num_threads workers solves and formats the previous block, in chunks that
+// are written out in input order. Returns the number of games read;
+// malformed lines are counted in *bad_lines. solve must be thread-safe.
+size_t runTextBatch(FILE* in, FILE* out, const TextBatchOptions& options, const vector<string>& columns,
+                    TextBatchSolveFn solve, size_t* bad_lines = nullptr);
+
+// Command-line options of the batch mode shared by the solver tools:
+//   --batch [FILE]   read games from FILE ("-" or omitted: stdin)
+//   --output FILE    write results to FILE instead of stdout (also -o)
+//   --tsv            separate output fields with tabs instead of commas
+//   --threads N      solver threads (default: hardware concurrency)
+//   --cache          answer repeated games from a cache keyed by canonical form
+//                    (game_3x3_solver only)
+struct TextBatchArgs {
+    bool enabled;
+    string input;
+    string output;
+    char delimiter;
+    int num_threads;
+    bool cache;
+    
+    TextBatchArgs() : enabled(false), input("-"), output("-"), delimiter(','), num_threads(0), cache(false) {}
+};
+
+// Parse the batch options; returns false (with a message on cerr) on a malformed command line
+bool parseTextBatchArgs(int argc, char* argv[], TextBatchArgs& args);
+
+// Open the files named in args, run the batch and report a summary on stderr.
+// Returns the process exit code.
+int runTextBatchCommand(const TextBatchArgs& args, int payoffs_per_game, const vector<string>& columns,
+                        TextBatchSolveFn solve);
+
+#endif // TEXT_BATCH_H